@@ -0,0 +1,83 @@
+#include "CommonUtils/DataHandler.h"
+#include "CommonUtils/RingBuffer.h"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <vector>
+
+// Producer-to-listener throughput of DataHandler for each queue backend.
+// Every iteration pushes kItems in total, split over the producer threads,
+// and ends once the listener has seen all of them.
+
+namespace
+{
+constexpr int64_t kItems = 1 << 20;
+
+using Locked = CommonUtils::DataHandler<int64_t>;
+using RingMpsc = CommonUtils::DataHandler<int64_t, CommonUtils::RingBuffer<int64_t, 16384>>;
+using RingSpsc = CommonUtils::DataHandler<int64_t,
+    CommonUtils::RingBuffer<int64_t, 16384, CommonUtils::ProducerMode::Single>>;
+
+template <typename Handler>
+void runProducers(benchmark::State &state)
+{
+    const int producers = static_cast<int>(state.range(0));
+    const int64_t perProducer = kItems / producers;
+    const int64_t total = perProducer * producers;
+
+    Handler handler;
+    std::atomic<int64_t> received{0};
+    handler.registerListener([&received](const int64_t &) {
+        received.fetch_add(1, std::memory_order_relaxed);
+    });
+
+    for (auto _ : state)
+    {
+        received.store(0);
+
+        std::vector<std::thread> threads;
+        for (int p = 0; p < producers; ++p)
+        {
+            threads.emplace_back([&handler, perProducer]() {
+                for (int64_t i = 0; i < perProducer; ++i)
+                {
+                    handler.signalData(i);
+                }
+            });
+        }
+        for (auto &thread : threads)
+        {
+            thread.join();
+        }
+
+        while (received.load(std::memory_order_relaxed) < total)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * total);
+}
+}
+
+static void BM_DataHandler_LockedQueue(benchmark::State &state)
+{
+    runProducers<Locked>(state);
+}
+
+static void BM_DataHandler_RingMpsc(benchmark::State &state)
+{
+    runProducers<RingMpsc>(state);
+}
+
+static void BM_DataHandler_RingSpsc(benchmark::State &state)
+{
+    runProducers<RingSpsc>(state);
+}
+
+BENCHMARK(BM_DataHandler_LockedQueue)->ArgName("producers")->Arg(1)->Arg(4)->Arg(16)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DataHandler_RingMpsc)->ArgName("producers")->Arg(1)->Arg(4)->Arg(16)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_DataHandler_RingSpsc)->ArgName("producers")->Arg(1)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
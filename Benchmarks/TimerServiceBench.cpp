@@ -0,0 +1,112 @@
+#include "CommonUtils/TimerService.h"
+#include "CommonUtils/Timer.h"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+// Cost of keeping kTimers timers alive at once on a single TimerService:
+// arming and cancelling them, snoozing them, and letting them all fire.
+
+namespace
+{
+constexpr int kTimers = 100000;
+
+using CommonUtils::TimerService;
+using Clock = TimerService::Clock;
+}
+
+static void BM_TimerService_ScheduleCancel(benchmark::State &state)
+{
+    TimerService service;
+    std::vector<TimerService::TimerId> ids(kTimers);
+
+    for (auto _ : state)
+    {
+        auto deadline = Clock::now() + std::chrono::seconds(60);
+        for (int i = 0; i < kTimers; ++i)
+        {
+            ids[i] = service.schedule(deadline + std::chrono::milliseconds(i), []() {});
+        }
+        for (int i = 0; i < kTimers; ++i)
+        {
+            service.cancel(ids[i]);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * kTimers);
+}
+
+static void BM_TimerService_Reschedule(benchmark::State &state)
+{
+    TimerService service;
+    std::vector<TimerService::TimerId> ids(kTimers);
+    auto deadline = Clock::now() + std::chrono::seconds(60);
+    for (int i = 0; i < kTimers; ++i)
+    {
+        ids[i] = service.schedule(deadline, []() {});
+    }
+
+    for (auto _ : state)
+    {
+        // Watchdog pattern: every timer pushed out again before it fires
+        auto later = Clock::now() + std::chrono::seconds(60);
+        for (int i = 0; i < kTimers; ++i)
+        {
+            service.reschedule(ids[i], later);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * kTimers);
+}
+
+static void BM_TimerService_FireAll(benchmark::State &state)
+{
+    TimerService service;
+    std::atomic<int> fired{0};
+
+    for (auto _ : state)
+    {
+        fired.store(0);
+        auto now = Clock::now();
+        for (int i = 0; i < kTimers; ++i)
+        {
+            // Spread over 100 ms
+            service.schedule(now + std::chrono::microseconds(i), [&fired]() {
+                fired.fetch_add(1, std::memory_order_relaxed);
+            });
+        }
+        while (fired.load(std::memory_order_relaxed) < kTimers)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * kTimers);
+}
+
+static void BM_Timer_Handles(benchmark::State &state)
+{
+    // Timer handles over the shared service; no thread per timer
+    for (auto _ : state)
+    {
+        std::vector<std::unique_ptr<CommonUtils::Timer>> timers;
+        timers.reserve(kTimers);
+        for (int i = 0; i < kTimers; ++i)
+        {
+            timers.push_back(std::make_unique<CommonUtils::Timer>());
+            timers.back()->startOneShot([]() {}, 60000);
+        }
+    }
+
+    state.SetItemsProcessed(state.iterations() * kTimers);
+}
+
+BENCHMARK(BM_TimerService_ScheduleCancel)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TimerService_Reschedule)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_TimerService_FireAll)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_Timer_Handles)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,150 @@
+#include "ZyrePublisher.h"
+#include "ZyreSubscriber.h"
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <thread>
+
+#include <czmq.h>
+
+#include <MessageOne.pb.h>
+
+// Cost of turning a protobuf into a zmsg ready for zyre_shout, comparing the
+// old string-then-copy path with serializing straight into the zframe.
+
+namespace
+{
+constexpr const char *kNamespace = "ZyrePublisherBench";
+
+MessageOne makeMessage(int64_t payloadSize)
+{
+    MessageOne msg;
+    msg.set_mcmessagestring(std::string(static_cast<size_t>(payloadSize), 'x'));
+    msg.set_mntime(1);
+    return msg;
+}
+
+// Publisher with a local subscriber in its group, so publish() does real
+// work instead of short-circuiting. Shared by all benchmark threads.
+struct SharedPublisher
+{
+    ZyrePublisher pub;
+    ZyreSubscriber sub;
+
+    explicit SharedPublisher(bool multiProducer) :
+        pub(kNamespace),
+        sub(kNamespace)
+    {
+        if (multiProducer)
+        {
+            pub.enableMultiProducer();
+        }
+        sub.subscribeView("Producers", [](std::string_view, std::string_view) {});
+        pub.start();
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (!pub.hasSubscribers("Producers") && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+    }
+};
+
+std::unique_ptr<SharedPublisher> sharedPublisher;
+
+void runProducers(benchmark::State &state, bool multiProducer)
+{
+    if (state.thread_index() == 0)
+    {
+        sharedPublisher = std::make_unique<SharedPublisher>(multiProducer);
+    }
+    MessageOne msg = makeMessage(100);
+
+    for (auto _ : state)
+    {
+        sharedPublisher->pub.publish("Producers", msg);
+    }
+    state.SetItemsProcessed(state.iterations());
+
+    if (state.thread_index() == 0)
+    {
+        sharedPublisher.reset();
+    }
+}
+}
+
+// Before: SerializeToString, rebuild the group name, zmsg_addmem copies again
+static void BM_BuildZmsg_StringCopy(benchmark::State &state)
+{
+    MessageOne msg = makeMessage(state.range(0));
+    const std::string nodeName = kNamespace;
+    const std::string topic = "MessageOne";
+
+    for (auto _ : state)
+    {
+        std::string serialized;
+        msg.SerializeToString(&serialized);
+        std::string namespacedTopic = nodeName + "/" + topic;
+        zmsg_t *zmsg = zmsg_new();
+        zmsg_addmem(zmsg, serialized.data(), serialized.size());
+        benchmark::DoNotOptimize(namespacedTopic.data());
+        zmsg_destroy(&zmsg);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(msg.ByteSizeLong()));
+}
+
+// After: size the frame, serialize into it, reuse the cached group name
+static void BM_BuildZmsg_DirectFrame(benchmark::State &state)
+{
+    MessageOne msg = makeMessage(state.range(0));
+    const std::string namespacedTopic = std::string(kNamespace) + "/MessageOne";
+
+    for (auto _ : state)
+    {
+        size_t size = msg.ByteSizeLong();
+        zframe_t *frame = zframe_new(nullptr, size);
+        msg.SerializeToArray(zframe_data(frame), static_cast<int>(size));
+        zmsg_t *zmsg = zmsg_new();
+        zmsg_append(zmsg, &frame);
+        benchmark::DoNotOptimize(namespacedTopic.data());
+        zmsg_destroy(&zmsg);
+    }
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(msg.ByteSizeLong()));
+}
+
+// End to end publish() call. With no peer in the group this measures the
+// short-circuit taken before serialization.
+static void BM_ZyrePublisher_Publish(benchmark::State &state)
+{
+    MessageOne msg = makeMessage(state.range(0));
+    ZyrePublisher pub(kNamespace);
+    pub.start();
+
+    for (auto _ : state)
+    {
+        pub.publish("MessageOne", msg);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(state.iterations() * static_cast<int64_t>(msg.ByteSizeLong()));
+}
+
+// Before: every producer thread shouts itself, serialized on the node mutex
+static void BM_ZyrePublisher_Producers_Mutex(benchmark::State &state)
+{
+    runProducers(state, false);
+}
+
+// After: producers serialize in parallel and hand frames to the sender thread
+static void BM_ZyrePublisher_Producers_Actor(benchmark::State &state)
+{
+    runProducers(state, true);
+}
+
+BENCHMARK(BM_BuildZmsg_StringCopy)->Arg(100)->Arg(100 * 1024);
+BENCHMARK(BM_BuildZmsg_DirectFrame)->Arg(100)->Arg(100 * 1024);
+BENCHMARK(BM_ZyrePublisher_Publish)->Arg(100)->Arg(100 * 1024);
+BENCHMARK(BM_ZyrePublisher_Producers_Mutex)->ThreadRange(1, 16)->UseRealTime();
+BENCHMARK(BM_ZyrePublisher_Producers_Actor)->ThreadRange(1, 16)->UseRealTime();
+
+BENCHMARK_MAIN();
@@ -0,0 +1,98 @@
+#include "ZyreRpcNode.h"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+// Request/reply throughput between two nodes in one process, keeping a
+// fixed number of calls in flight (pipelining depth).
+
+namespace
+{
+constexpr const char *kNamespace = "ZyreRpcBench";
+constexpr int kBatch = 1000;
+constexpr unsigned int kTimeoutMs = 5000;
+
+struct RpcPair
+{
+    ZyreRpcNode server{kNamespace};
+    ZyreRpcNode client{kNamespace};
+    std::string peer;
+
+    bool connect()
+    {
+        server.registerMethod("echo", [](std::string_view request, std::string &response)
+        {
+            response.assign(request.data(), request.size());
+            return true;
+        });
+        server.start();
+        client.start();
+
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(10);
+        while (std::chrono::steady_clock::now() < deadline)
+        {
+            auto servers = client.servers();
+            if (!servers.empty())
+            {
+                peer = servers.front();
+                return true;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        return false;
+    }
+};
+}
+
+static void BM_ZyreRpc_Pipelined(benchmark::State &state)
+{
+    const int64_t depth = state.range(0);
+    const std::string payload(64, 'x');
+
+    RpcPair pair;
+    if (!pair.connect())
+    {
+        state.SkipWithError("Discovery timed out");
+        return;
+    }
+
+    std::atomic<int64_t> inFlight{0};
+    std::atomic<int64_t> failures{0};
+    auto onReply = [&inFlight, &failures](const RpcReply &reply)
+    {
+        if (reply.status != RpcStatus::Ok)
+        {
+            failures.fetch_add(1);
+        }
+        inFlight.fetch_sub(1);
+    };
+
+    for (auto _ : state)
+    {
+        for (int i = 0; i < kBatch; ++i)
+        {
+            while (inFlight.load() >= depth)
+            {
+                std::this_thread::yield();
+            }
+            inFlight.fetch_add(1);
+            pair.client.call(pair.peer, "echo", payload.data(), payload.size(), kTimeoutMs, onReply);
+        }
+        while (inFlight.load() > 0)
+        {
+            std::this_thread::yield();
+        }
+    }
+
+    if (failures.load() > 0)
+    {
+        state.SkipWithError("Calls failed");
+    }
+    state.SetItemsProcessed(state.iterations() * kBatch);
+}
+
+BENCHMARK(BM_ZyreRpc_Pipelined)->ArgName("depth")->Arg(1)->Arg(16)->Arg(256)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
@@ -0,0 +1,198 @@
+#include "ZyrePublisher.h"
+#include "ZyreSubscriber.h"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <string>
+#include <thread>
+
+#include <csignal>
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <czmq.h>
+
+#include <MessageOne.pb.h>
+
+extern char **environ;
+
+// Time from starting a subscriber until it receives its first message from
+// a publisher in another local process, for several discovery settings.
+// The publisher process is this executable re-run with --startup-child.
+
+namespace
+{
+constexpr const char *kChildFlag = "--startup-child";
+constexpr const char *kSelf = "/proc/self/exe";
+constexpr const char *kTopic = "Startup";
+
+enum Config
+{
+    kDefault,
+    kFastBeacon,
+    kGossip
+};
+
+// Ports for one run; unique per run so back-to-back runs never collide
+struct Ports
+{
+    int publisher;
+    int subscriber;
+    int hub;
+};
+
+// Both processes derive the same ports from the parent's pid
+Ports portsFor(pid_t parent, int run)
+{
+    int base = 20000 + (parent % 1000) * 30 + (run % 10) * 3;
+    return Ports{base, base + 1, base + 2};
+}
+
+ZyreNodeConfig makeConfig(Config config, bool publisher, pid_t parent, int run)
+{
+    ZyreNodeConfig result;
+    switch (config)
+    {
+    case kDefault:
+        break;
+    case kFastBeacon:
+        result.beaconIntervalMs = 100;
+        result.evasiveTimeoutMs = 500;
+        result.expiredTimeoutMs = 2000;
+        break;
+    case kGossip:
+    {
+        Ports ports = portsFor(parent, run);
+        std::string hub = "tcp://127.0.0.1:" + std::to_string(ports.hub);
+        result.endpoint = "tcp://127.0.0.1:" + std::to_string(publisher ? ports.publisher : ports.subscriber);
+        if (publisher)
+        {
+            result.gossipBind = hub;
+        }
+        else
+        {
+            result.gossipConnect = hub;
+        }
+        break;
+    }
+    }
+    return result;
+}
+
+std::string namespaceFor(pid_t parent, int run)
+{
+    return "ZyreStartupBench." + std::to_string(parent) + "." + std::to_string(run);
+}
+
+volatile sig_atomic_t childRunning = 1;
+
+void stopChild(int)
+{
+    childRunning = 0;
+}
+
+// Publisher side: publish until told to stop (or give up after 30 s)
+int runChild(Config config, pid_t parent, int run)
+{
+    zsys_handler_set(NULL);
+    signal(SIGTERM, stopChild);
+
+    ZyrePublisher pub(namespaceFor(parent, run), nullptr, makeConfig(config, true, parent, run));
+    if (!pub.start())
+    {
+        return 1;
+    }
+
+    MessageOne msg;
+    msg.set_mcmessagestring("startup");
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(30);
+    while (childRunning && std::chrono::steady_clock::now() < deadline)
+    {
+        pub.publish(kTopic, msg);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return 0;
+}
+
+pid_t spawnChild(Config config, int run)
+{
+    std::string configArg = std::to_string(config);
+    std::string parentArg = std::to_string(getpid());
+    std::string runArg = std::to_string(run);
+    char *argv[] = {const_cast<char*>(kSelf), const_cast<char*>(kChildFlag), configArg.data(),
+                    parentArg.data(), runArg.data(), nullptr};
+
+    pid_t pid = -1;
+    if (posix_spawn(&pid, kSelf, nullptr, nullptr, argv, environ) != 0)
+    {
+        return -1;
+    }
+    return pid;
+}
+
+int nextRun = 0;
+}
+
+static void BM_ZyreStartup_TimeToFirstMessage(benchmark::State &state)
+{
+    Config config = static_cast<Config>(state.range(0));
+
+    for (auto _ : state)
+    {
+        int run = nextRun++;
+        auto start = std::chrono::steady_clock::now();
+
+        pid_t child = spawnChild(config, run);
+        if (child < 0)
+        {
+            state.SkipWithError("Failed to spawn publisher");
+            break;
+        }
+
+        std::atomic<bool> received{false};
+        bool ok;
+        {
+            ZyreSubscriber sub(namespaceFor(getpid(), run), nullptr, makeConfig(config, false, getpid(), run));
+            sub.subscribeView(kTopic, [&received](std::string_view, std::string_view) { received.store(true); });
+
+            auto deadline = start + std::chrono::seconds(30);
+            while (!received.load() && std::chrono::steady_clock::now() < deadline)
+            {
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+            }
+            ok = received.load();
+            state.SetIterationTime(std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        kill(child, SIGTERM);
+        waitpid(child, nullptr, 0);
+
+        if (!ok)
+        {
+            state.SkipWithError("No message within 30 s");
+            break;
+        }
+    }
+}
+
+BENCHMARK(BM_ZyreStartup_TimeToFirstMessage)
+    ->ArgName("config")->Arg(kDefault)->Arg(kFastBeacon)->Arg(kGossip)
+    ->Iterations(5)->UseManualTime()->Unit(benchmark::kMillisecond);
+
+int main(int argc, char **argv)
+{
+    if (argc == 5 && strcmp(argv[1], kChildFlag) == 0)
+    {
+        return runChild(static_cast<Config>(std::atoi(argv[2])),
+                        static_cast<pid_t>(std::atoi(argv[3])), std::atoi(argv[4]));
+    }
+
+    zsys_handler_set(NULL);
+
+    benchmark::Initialize(&argc, argv);
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
@@ -0,0 +1,130 @@
+#include "ZyrePublisher.h"
+#include "ZyreSubscriber.h"
+#include <benchmark/benchmark.h>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <thread>
+
+#include <MessageOne.pb.h>
+
+// Receive throughput of ZyreSubscriber for small payloads, comparing the
+// copying std::string handler against the zero-copy view handler.
+
+namespace
+{
+constexpr const char *kNamespace = "ZyreSubscriberBench";
+constexpr int kBatch = 1000;
+
+bool waitForCount(const std::atomic<int64_t> &count, int64_t target, std::chrono::milliseconds timeout)
+{
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (count.load() < target)
+    {
+        if (std::chrono::steady_clock::now() > deadline)
+        {
+            return false;
+        }
+        std::this_thread::yield();
+    }
+    return true;
+}
+
+// Publisher/subscriber pair that has completed discovery
+struct NodePair
+{
+    ZyrePublisher pub{kNamespace};
+    ZyreSubscriber sub{kNamespace};
+    std::atomic<int64_t> received{0};
+
+    bool connect(const std::string &topic, const MessageOne &probe)
+    {
+        pub.start();
+
+        // Publish until the subscriber has joined and sees traffic
+        for (int attempt = 0; attempt < 100; ++attempt)
+        {
+            pub.publish(topic, probe);
+            if (waitForCount(received, 1, std::chrono::milliseconds(100)))
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+};
+
+void runBatches(benchmark::State &state, NodePair &pair, const std::string &topic, const MessageOne &msg)
+{
+    for (auto _ : state)
+    {
+        int64_t target = pair.received.load() + kBatch;
+        for (int i = 0; i < kBatch; ++i)
+        {
+            pair.pub.publish(topic, msg);
+        }
+        if (!waitForCount(pair.received, target, std::chrono::seconds(10)))
+        {
+            state.SkipWithError("Messages lost");
+            break;
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * kBatch);
+    state.SetBytesProcessed(state.iterations() * kBatch * static_cast<int64_t>(msg.ByteSizeLong()));
+}
+
+MessageOne makeMessage(int64_t payloadSize)
+{
+    MessageOne msg;
+    msg.set_mcmessagestring(std::string(static_cast<size_t>(payloadSize), 'x'));
+    msg.set_mntime(1);
+    return msg;
+}
+}
+
+// Before: handler receives freshly allocated std::string copies
+static void BM_ZyreSubscriber_StringHandler(benchmark::State &state)
+{
+    const std::string topic = "String" + std::to_string(state.range(0));
+    MessageOne msg = makeMessage(state.range(0));
+
+    NodePair pair;
+    pair.sub.subscribe(topic, [&pair](const std::string &, const std::string &data)
+    {
+        benchmark::DoNotOptimize(data.data());
+        pair.received.fetch_add(1);
+    });
+
+    if (!pair.connect(topic, msg))
+    {
+        state.SkipWithError("Discovery timed out");
+        return;
+    }
+    runBatches(state, pair, topic, msg);
+}
+
+// After: handler views the zframe in place
+static void BM_ZyreSubscriber_ViewHandler(benchmark::State &state)
+{
+    const std::string topic = "View" + std::to_string(state.range(0));
+    MessageOne msg = makeMessage(state.range(0));
+
+    NodePair pair;
+    pair.sub.subscribeView(topic, [&pair](std::string_view, std::string_view data)
+    {
+        benchmark::DoNotOptimize(data.data());
+        pair.received.fetch_add(1);
+    });
+
+    if (!pair.connect(topic, msg))
+    {
+        state.SkipWithError("Discovery timed out");
+        return;
+    }
+    runBatches(state, pair, topic, msg);
+}
+
+BENCHMARK(BM_ZyreSubscriber_StringHandler)->Arg(16)->Arg(64)->Arg(256)->Iterations(50)->UseRealTime()->Unit(benchmark::kMillisecond);
+BENCHMARK(BM_ZyreSubscriber_ViewHandler)->Arg(16)->Arg(64)->Arg(256)->Iterations(50)->UseRealTime()->Unit(benchmark::kMillisecond);
+
+BENCHMARK_MAIN();
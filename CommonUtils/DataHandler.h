@@ -2,33 +2,352 @@
 #define COMMONUTILS_DATAHANDLER_H
 #include <functional>
 #include <map>
-#include <queue>
 #include <mutex>
 #include <condition_variable>
+#include <deque>
 #include <memory>
 #include <thread>
+#include <algorithm>
 #include <atomic>
+#include <chrono>
+#include <cstdint>
 #include <iostream>
+#include <iterator>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+#include "CommonUtils/LatencyHistogram.h"
+#include "CommonUtils/RingBuffer.h"
 
 namespace CommonUtils
 {
+/**
+ * @brief What a bounded queue does with an item that arrives while it is full.
+ */
+enum class OverflowPolicy
+{
+    Block,       ///< The producer waits for space
+    DropNewest,  ///< The arriving item is discarded
+    DropOldest,  ///< The oldest queued item is discarded to make room
+    Conflate     ///< An item replaces the queued one with the same key
+};
+
+/**
+ * @class LockedQueue
+ * @brief Mutex protected queue. Default backend of DataHandler.
+ *        The consumer takes everything queued at once by swapping buffers,
+ *        so it costs one lock round-trip per batch rather than per item.
+ *        Unbounded unless setLimit() is called.
+ */
+template <typename T>
+class LockedQueue {
+public:
+    using KeyFunction = std::function<std::string(const T&)>;
+
+    /**
+     * @brief Bounds the queue. Call before any item is queued.
+     * @param capacity Maximum number of queued items; 0 is unbounded.
+     * @param policy   What to do with an item arriving while full.
+     * @param key      Key extractor, required by OverflowPolicy::Conflate.
+     *                 Conflation applies whether or not the queue is full,
+     *                 so only the latest item per key is ever queued; a new
+     *                 key arriving while full is dropped.
+     * @return false, changing nothing, if policy is Conflate without a key.
+     */
+    bool setLimit(size_t capacity, OverflowPolicy policy, KeyFunction key = nullptr)
+    {
+        if (policy == OverflowPolicy::Conflate && !key)
+        {
+            std::cerr << "OverflowPolicy::Conflate needs a key function\n";
+            return false;
+        }
+
+        std::lock_guard<std::mutex> lock(_mutex);
+        _capacity = capacity;
+        _policy = policy;
+        _key = std::move(key);
+        return true;
+    }
+
+    template <typename U>
+    bool push(U &&item)
+    {
+        return emplace(std::forward<U>(item));
+    }
+
+    /**
+     * @return false if the queue is full and the policy is Block; the
+     *         arguments are then left untouched.
+     */
+    template <typename... Args>
+    bool emplace(Args &&... args)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        bool full = _capacity > 0 && _items.size() - _front >= _capacity;
+
+        if (_policy == OverflowPolicy::Conflate)
+        {
+            T item(std::forward<Args>(args)...);
+            std::string key = _key(item);
+            auto slot = _slots.find(key);
+            if (slot != _slots.end())
+            {
+                _items[slot->second] = std::move(item);
+                ++_conflated;
+            }
+            else if (full)
+            {
+                ++_dropped;
+            }
+            else
+            {
+                _slots.emplace(std::move(key), _items.size());
+                _items.push_back(std::move(item));
+            }
+            return true;
+        }
+
+        if (full)
+        {
+            switch (_policy)
+            {
+            case OverflowPolicy::DropNewest:
+                ++_dropped;
+                return true;
+            case OverflowPolicy::DropOldest:
+                // Release the payload now; the slot is skipped by popAll()
+                _items[_front++] = T();
+                ++_dropped;
+                if (_front >= _capacity)
+                {
+                    // Compact so a stalled consumer cannot grow the buffer
+                    _items.erase(_items.begin(), _items.begin() + static_cast<std::ptrdiff_t>(_front));
+                    _front = 0;
+                }
+                break;
+            default:
+                return false;
+            }
+        }
+
+        _items.emplace_back(std::forward<Args>(args)...);
+        return true;
+    }
+
+    /**
+     * @brief Moves every queued item into out, which must be empty. Its
+     *        capacity is handed back to the producers for reuse.
+     * @return false if nothing was queued.
+     */
+    bool popAll(std::vector<T> &out)
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (_items.size() == _front)
+        {
+            return false;
+        }
+
+        if (_front == 0)
+        {
+            out.swap(_items);
+        }
+        else
+        {
+            out.assign(std::make_move_iterator(_items.begin() + static_cast<std::ptrdiff_t>(_front)),
+                       std::make_move_iterator(_items.end()));
+            _items.clear();
+            _front = 0;
+        }
+        _slots.clear();
+        return true;
+    }
+
+    bool empty() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _items.size() == _front;
+    }
+
+    size_t size() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _items.size() - _front;
+    }
+
+    /**
+     * @brief Items discarded by DropNewest or DropOldest.
+     */
+    uint64_t dropped() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _dropped;
+    }
+
+    /**
+     * @brief Items replaced by a newer one with the same key.
+     */
+    uint64_t conflated() const
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        return _conflated;
+    }
+
+private:
+    mutable std::mutex _mutex;
+    std::vector<T> _items;
+    size_t _front = 0;  // Items before this were dropped by DropOldest
+    size_t _capacity = 0;
+    OverflowPolicy _policy = OverflowPolicy::Block;
+    KeyFunction _key;
+    std::unordered_map<std::string, size_t> _slots;  // Conflate: key to index in _items
+    uint64_t _dropped = 0;
+    uint64_t _conflated = 0;
+};
+
+/**
+ * @brief Detects backends that keep overflow counts, like LockedQueue.
+ */
+template <typename Queue, typename = void>
+struct HasOverflowCounts : std::false_type {};
+
+template <typename Queue>
+struct HasOverflowCounts<Queue, std::void_t<decltype(std::declval<const Queue&>().dropped()),
+                                            decltype(std::declval<const Queue&>().conflated())>>
+    : std::true_type {};
+
+/**
+ * @brief Storage tag for DataHandler: DataHandler<SharedStorage<T>> queues
+ *        std::shared_ptr<const T> so a payload is allocated once and shared
+ *        by every listener instead of being copied into the queue.
+ */
+template <typename T>
+struct SharedStorage {};
+
+/**
+ * @brief Maps a DataHandler element type to what its queue stores.
+ */
+template <typename T>
+struct DataStorage
+{
+    using Value = T;
+    using Stored = T;
+    static const Value &value(const Stored &stored) { return stored; }
+};
+
+template <typename T>
+struct DataStorage<SharedStorage<T>>
+{
+    using Value = T;
+    using Stored = std::shared_ptr<const T>;
+    static const Value &value(const Stored &stored) { return *stored; }
+};
+
+/**
+ * @brief How DataHandler runs its listeners.
+ */
+enum class DispatchMode
+{
+    Serial,       ///< All listeners in turn on the worker thread
+    PerListener,  ///< Each listener on its own thread
+    Pooled        ///< Listeners in parallel on a shared thread pool
+};
+
 /**
  * @class DataHandler
  * @brief Implements a thread safe queue.
  *        * Listeners can register an std::function to listen for new data
  *        * Any thread can signal that new data is available.
  *        * listener functions are executed in a common, but separate thread,
+ *
+ *        Data is moved through the queue: an rvalue or emplaced item is never
+ *        copied, and all listeners see the same instance.
+ *        * The worker drains everything pending in one go and dispatches it
+ *          as a batch: per-item listeners are called for each item in
+ *          order, batch listeners once with the whole batch.
+ *        * Listeners are called without any lock held. They may register
+ *          or unregister listeners, including themselves, from a callback.
+ *        * In the PerListener and Pooled dispatch modes the worker hands each
+ *          drained batch to every listener's own cursor instead of calling
+ *          them, so a slow listener only delays itself. Each listener still
+ *          sees items in order, one callback at a time. listenerLag() shows
+ *          how far behind each one is. setCapacity() bounds each
+ *          listener's backlog as well as the queue; without it, or with
+ *          a RingBuffer backend, the backlogs are unbounded.
+ *        * metrics() returns counters kept per producer thread and per
+ *          listener, so collecting them never contends with signalData().
+ *          Timings are only taken after enableMetrics().
+ *
+ * @tparam T     Element type, or SharedStorage<T> to queue shared pointers.
+ * @tparam Queue Queue backend: LockedQueue (default, unbounded) or a
+ *               RingBuffer (bounded, lock-free) of DataStorage<T>::Stored.
+ *               A bounded backend makes signalData() wait while it is full.
  */
-template <typename T>
+template <typename T, typename Queue = LockedQueue<typename DataStorage<T>::Stored>>
 class DataHandler {
 public:
-    using Listener = std::function<void(const T&)>;
+    using Value = typename DataStorage<T>::Value;
+    using Stored = typename DataStorage<T>::Stored;
+    using Listener = std::function<void(const Value&)>;
+    using Batch = std::vector<Stored>;
+    using BatchListener = std::function<void(const Batch&)>;
+
+    /**
+     * @brief Counters of one listener, see metrics().
+     */
+    struct ListenerMetrics
+    {
+        int id;
+        uint64_t delivered;   ///< Items the listener has finished with
+        uint64_t exceptions;  ///< Callbacks that threw
+        uint64_t dropped;     ///< Items discarded from its own full backlog
+        LatencyHistogram::Snapshot callbackTime;  ///< Time per callback
+    };
+
+    /**
+     * @brief Snapshot returned by metrics().
+     */
+    struct Metrics
+    {
+        uint64_t enqueued = 0;      ///< Items signaled, including dropped and conflated ones
+        uint64_t dequeued = 0;      ///< Items taken out of the queue by the worker
+        uint64_t dropped = 0;       ///< Items discarded by DropNewest or DropOldest
+        uint64_t conflated = 0;     ///< Items replaced by a newer one with the same key
+        size_t queued = 0;          ///< Items in the queue right now
+        size_t highWaterMark = 0;   ///< Most items drained at once, i.e. the deepest the queue got
+        size_t producerThreads = 0; ///< Running threads that have signaled this handler
+        LatencyHistogram::Snapshot dispatchLatency;  ///< Age of each batch's oldest item at dispatch
+        std::vector<ListenerMetrics> listeners;
+    };
+
+    /**
+     * @brief Progress of one listener.
+     */
+    struct ListenerLag
+    {
+        int id;
+        uint64_t delivered;  ///< Items the listener has finished with
+        uint64_t pending;    ///< Items signaled but not yet delivered to it
+    };
 
     /**
      * @brief Constructor
+     * @param mode        How listeners are run.
+     * @param poolThreads Size of the Pooled mode thread pool; 0 uses one
+     *                    thread per hardware thread.
      */
-    DataHandler() : _stopFlag(false)
+    explicit DataHandler(DispatchMode mode = DispatchMode::Serial, size_t poolThreads = 0) :
+        _mode(mode), _stopFlag(false)
     {
+        if (_mode == DispatchMode::Pooled)
+        {
+            if (poolThreads == 0)
+            {
+                poolThreads = std::max(1u, std::thread::hardware_concurrency());
+            }
+            _executor = std::make_unique<Executor>(poolThreads);
+        }
         _workerThread = std::thread(&DataHandler::processData, this);
     }
 
@@ -37,39 +356,100 @@ public:
      */
     ~DataHandler()
     {
-        _stopFlag = true;
+        {
+            std::lock_guard<std::mutex> lock(_cvMutex);
+            _stopFlag = true;
+        }
         _condVar.notify_all();
+        {
+            // Release producers blocked on a full queue
+            std::lock_guard<std::mutex> lock(_spaceMutex);
+            _spaceCV.notify_all();
+        }
+        {
+            // Release the worker if it is blocked on a full listener backlog
+            std::lock_guard<std::mutex> lock(_listenersMutex);
+            for (const auto &channel : _listeners->channels)
+            {
+                std::lock_guard<std::mutex> channelLock(channel.second->mutex);
+                channel.second->cv.notify_all();
+            }
+        }
         // Wait for the worker thread to finish processing
         if (_workerThread.joinable())
         {
             _workerThread.join();
         }
 
-        // Clear all listeners and data queue
+        // Stop the listeners' own threads, then the pool
+        ListenerSnapshot listeners;
         {
             std::lock_guard<std::mutex> lock(_listenersMutex);
-            _listeners.clear();
+            listeners = _listeners;
+        }
+        for (const auto &channel : listeners->channels)
+        {
+            stopChannel(channel.second);
+        }
+        _executor.reset();
+        {
+            std::lock_guard<std::mutex> lock(_retiredMutex);
+            for (const auto &channel : _retired)
+            {
+                channel->thread.join();
+            }
         }
 
-        while (!_dataQueue.empty())
+        // Clear all listeners; the queue releases what is left in it
         {
-            _dataQueue.pop();
+            std::lock_guard<std::mutex> lock(_listenersMutex);
+            _listeners.reset();
         }
     }
 
     /**
      * @brief Indicates new data is available for the listeners to consume.
+     * @param data Copied into the queue.
+     */
+    void signalData(const Value& data)
+    {
+        emplace(data);
+    }
+
+    /**
+     * @brief Indicates new data is available for the listeners to consume.
+     * @param data Moved into the queue.
+     */
+    void signalData(Value&& data)
+    {
+        emplace(std::move(data));
+    }
+
+    /**
+     * @brief Shares an already allocated payload with the listeners.
+     *        Only available with SharedStorage.
      * @param data
      */
-    void signalData(const T& data)
+    template <typename S = Stored, typename = std::enable_if_t<!std::is_same<S, Value>::value>>
+    void signalData(std::shared_ptr<const Value> data)
     {
-        if (_stopFlag) return;
+        enqueue(std::move(data));
+    }
 
-        std::lock_guard<std::mutex> lock(_cvMutex);
+    /**
+     * @brief Constructs the new data in place from args.
+     */
+    template <typename... Args>
+    void emplace(Args&&... args)
+    {
+        if constexpr (std::is_same<Stored, Value>::value)
+        {
+            enqueue(std::forward<Args>(args)...);
+        }
+        else
         {
-            _dataQueue.push(data);
+            enqueue(std::make_shared<const Value>(std::forward<Args>(args)...));
         }
-        _condVar.notify_one();
     }
 
     /**
@@ -85,83 +465,878 @@ public:
         if (_stopFlag) return -1; // Prevent registration after stop
         std::lock_guard<std::mutex> lock(_listenersMutex);
         nextListenerId_++;
-        _listeners[nextListenerId_] = listener;
+        auto listeners = std::make_shared<ListenerTable>(*_listeners);
+        if (_mode == DispatchMode::Serial)
+        {
+            listeners->items[nextListenerId_] = {listener, std::make_shared<ListenerStats>()};
+        }
+        else
+        {
+            listeners->channels[nextListenerId_] = makeChannel(listener, nullptr);
+        }
+        publishListeners(std::move(listeners));
+        return nextListenerId_;
+    }
+
+    /**
+     * @brief Registers a function to be called once per drained batch
+     *        rather than once per item, so it can amortize its own
+     *        per-call overhead. With SharedStorage the batch holds the
+     *        shared pointers.
+     * @return A registration ID, from the same range as registerListener.
+     * @param listener
+     */
+    int registerBatchListener(const BatchListener &listener)
+    {
+        if (_stopFlag) return -1; // Prevent registration after stop
+        std::lock_guard<std::mutex> lock(_listenersMutex);
+        nextListenerId_++;
+        auto listeners = std::make_shared<ListenerTable>(*_listeners);
+        if (_mode == DispatchMode::Serial)
+        {
+            listeners->batches[nextListenerId_] = {listener, std::make_shared<ListenerStats>()};
+        }
+        else
+        {
+            listeners->channels[nextListenerId_] = makeChannel(nullptr, listener);
+        }
+        publishListeners(std::move(listeners));
         return nextListenerId_;
     }
 
     /**
      * @brief Unregisters a listener by its registration ID.
+     *        Once this returns the listener is not running and will not be
+     *        called again. Called from a listener, it only waits for the
+     *        current callback to return; its own ID can be passed.
      * @param id The registration ID returned by registerListener.
-     * @return true if a listener was removed, false otherwise.
      */
     void unregisterListener(int id)
     {
         if (_stopFlag) return; // Prevent deregistration after stop
-        std::lock_guard<std::mutex> lock(_listenersMutex);
-        _listeners.erase(id);
+        uint64_t version;
+        std::shared_ptr<Channel> channel;
+        {
+            std::lock_guard<std::mutex> lock(_listenersMutex);
+            auto found = _listeners->channels.find(id);
+            if (found != _listeners->channels.end())
+            {
+                channel = found->second;
+            }
+            else if (!_listeners->items.count(id) && !_listeners->batches.count(id))
+            {
+                return;
+            }
+            auto listeners = std::make_shared<ListenerTable>(*_listeners);
+            listeners->items.erase(id);
+            listeners->batches.erase(id);
+            listeners->channels.erase(id);
+            version = publishListeners(std::move(listeners));
+        }
+
+        if (channel)
+        {
+            // The worker never calls channel listeners, so only the channel
+            // itself needs to stop
+            stopChannel(channel);
+            return;
+        }
+
+        if (std::this_thread::get_id() == _workerThread.get_id())
+        {
+            return;
+        }
+
+        // Sleep until the worker is idle or has picked up the new table
+        _versionWaiters.fetch_add(1);
+        {
+            std::unique_lock<std::mutex> lock(_versionMutex);
+            _versionCV.wait(lock, [this, version] { return _activeVersion.load() >= version; });
+        }
+        _versionWaiters.fetch_sub(1);
+    }
+
+    /**
+     * @brief Bounds the queue. Only available with the LockedQueue backend;
+     *        a RingBuffer is bounded by its size and always blocks.
+     *        Call before signaling any data.
+     * @param capacity Maximum number of queued items; 0 is unbounded.
+     * @param policy   What to do with an item signaled while full.
+     * @param key      Key extractor for OverflowPolicy::Conflate: only the
+     *                 latest pending item per key is kept.
+     * @return false, leaving the queue as it was, if policy is Conflate
+     *         and no key is given.
+     *
+     * In the PerListener and Pooled modes each listener's backlog is held
+     * to the same capacity, in items. It overflows a whole drained batch
+     * at a time: Block makes the worker wait for the listener, DropNewest
+     * skips the batch for that listener, and DropOldest and Conflate
+     * discard its oldest pending batches. A batch larger than capacity is
+     * still accepted into an empty backlog.
+     */
+    bool setCapacity(size_t capacity, OverflowPolicy policy = OverflowPolicy::Block,
+                     std::function<std::string(const Value&)> key = nullptr)
+    {
+        typename Queue::KeyFunction storedKey;
+        if (key)
+        {
+            storedKey = [key](const Stored& data) { return key(DataStorage<T>::value(data)); };
+        }
+        if (!_dataQueue.setLimit(capacity, policy, std::move(storedKey)))
+        {
+            return false;
+        }
+        _channelCapacity = capacity;
+        _channelPolicy = policy;
+        return true;
     }
 
     /**
      * @brief Returns usage statistics of this class
      * @return std pair, first item is the number of listeners,
      *                   second is the number of dataum in the
-     *                   queue.
+     *                   queue. Overflow counts are in metrics().
      */
     std::pair <size_t, size_t> watermarkInfo()
     {        
         if (_stopFlag) return {0, 0};
 
-        std::lock_guard<std::mutex> lock(_listenersMutex);
-        return {_listeners.size(), _dataQueue.size()};
+        size_t listeners;
+        {
+            std::lock_guard<std::mutex> lock(_listenersMutex);
+            listeners = _listeners->items.size() + _listeners->batches.size() + _listeners->channels.size();
+        }
+        return {listeners, _dataQueue.size()};
+    }
+
+    /**
+     * @brief Returns how far behind each listener is.
+     *        In Serial mode all listeners share the worker's progress.
+     */
+    std::vector<ListenerLag> listenerLag()
+    {
+        ListenerSnapshot listeners;
+        {
+            std::lock_guard<std::mutex> lock(_listenersMutex);
+            listeners = _listeners;
+        }
+
+        std::vector<ListenerLag> result;
+        if (!listeners) return result;
+
+        uint64_t queued = _dataQueue.size();
+        uint64_t dispatched = _dispatched.load();
+        uint64_t serialPending = queued + _drained.load() - dispatched;
+        for (const auto &listener : listeners->items)
+        {
+            result.push_back({listener.first, dispatched, serialPending});
+        }
+        for (const auto &listener : listeners->batches)
+        {
+            result.push_back({listener.first, dispatched, serialPending});
+        }
+        for (const auto &channel : listeners->channels)
+        {
+            uint64_t delivered = channel.second->delivered.load();
+            uint64_t posted = channel.second->posted.load();
+            result.push_back({channel.first, delivered, queued + posted - delivered});
+        }
+        return result;
+    }
+
+    /**
+     * @brief Turns on the timing histograms of metrics(). Counters are
+     *        always kept; timings cost a clock read per callback.
+     */
+    void enableMetrics(bool enable = true)
+    {
+        _metricsEnabled.store(enable);
+    }
+
+    /**
+     * @brief Returns a consistent-per-counter snapshot of the queue and
+     *        listener metrics. Safe to call from any thread at any time.
+     */
+    Metrics metrics()
+    {
+        Metrics result;
+        {
+            std::lock_guard<std::mutex> lock(_producers->mutex);
+            result.enqueued = _producers->retired;
+            for (const auto &producer : _producers->live)
+            {
+                result.enqueued += producer->enqueued.load(std::memory_order_relaxed);
+            }
+            result.producerThreads = _producers->live.size();
+        }
+        result.dequeued = _drained.load();
+        result.queued = _dataQueue.size();
+        result.highWaterMark = _highWaterMark.load();
+        result.dispatchLatency = _dispatchLatency.snapshot();
+        if constexpr (HasOverflowCounts<Queue>::value)
+        {
+            result.dropped = _dataQueue.dropped();
+            result.conflated = _dataQueue.conflated();
+        }
+
+        ListenerSnapshot listeners;
+        {
+            std::lock_guard<std::mutex> lock(_listenersMutex);
+            listeners = _listeners;
+        }
+        if (!listeners) return result;
+
+        uint64_t dispatched = _dispatched.load();
+        for (const auto &listener : listeners->items)
+        {
+            result.listeners.push_back(listenerMetrics(listener.first, dispatched, *listener.second.stats));
+        }
+        for (const auto &listener : listeners->batches)
+        {
+            result.listeners.push_back(listenerMetrics(listener.first, dispatched, *listener.second.stats));
+        }
+        for (const auto &channel : listeners->channels)
+        {
+            result.listeners.push_back(listenerMetrics(channel.first, channel.second->delivered.load(),
+                                                       channel.second->stats));
+        }
+        return result;
     }
 
 private:
-    void processData() 
+    /**
+     * @brief Per-listener counters; only the thread running the listener
+     *        writes them.
+     */
+    struct ListenerStats
     {
-        while (!_stopFlag) 
+        LatencyHistogram callbackTime;
+        std::atomic<uint64_t> exceptions{0};
+        std::atomic<uint64_t> dropped{0};  // Channels only
+    };
+
+    template <typename Function>
+    struct Registered
+    {
+        Function function;
+        std::shared_ptr<ListenerStats> stats;  // Shared by every table copy
+    };
+
+    /**
+     * @brief Per-producer-thread counters, on their own cache line so
+     *        producers never write to a shared one.
+     */
+    struct alignas(64) ProducerCounters
+    {
+        std::atomic<uint64_t> enqueued{0};
+    };
+
+    /**
+     * @brief Counters of the producer threads of one handler. Shared with
+     *        those threads so an exiting thread can retire its counters
+     *        even if it outlives the handler.
+     */
+    struct ProducerRegistry
+    {
+        std::mutex mutex;
+        std::vector<std::unique_ptr<ProducerCounters>> live;  // One per running producer thread
+        uint64_t retired = 0;  // Items signaled by producer threads that have exited
+
+        void retire(ProducerCounters *counters)
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            auto it = std::find_if(live.begin(), live.end(),
+                [counters](const std::unique_ptr<ProducerCounters> &entry) { return entry.get() == counters; });
+            if (it != live.end())
+            {
+                retired += (*it)->enqueued.load(std::memory_order_relaxed);
+                live.erase(it);
+            }
+        }
+    };
+
+    /**
+     * @brief One thread's counters for every handler it has signaled.
+     *        Entries of destroyed handlers are pruned when the thread
+     *        meets a new handler; the rest are retired at thread exit.
+     */
+    struct ThreadProducers
+    {
+        struct Entry
+        {
+            std::weak_ptr<ProducerRegistry> registry;
+            ProducerCounters *counters;
+        };
+        std::unordered_map<uint64_t, Entry> entries;  // By handler instance ID
+
+        ~ThreadProducers()
+        {
+            for (auto &entry : entries)
+            {
+                if (auto registry = entry.second.registry.lock())
+                {
+                    registry->retire(entry.second.counters);
+                }
+            }
+        }
+
+        void prune()
+        {
+            for (auto it = entries.begin(); it != entries.end();)
+            {
+                it = it->second.registry.expired() ? entries.erase(it) : std::next(it);
+            }
+        }
+    };
+
+    static ListenerMetrics listenerMetrics(int id, uint64_t delivered, const ListenerStats &stats)
+    {
+        return {id, delivered, stats.exceptions.load(std::memory_order_relaxed),
+                stats.dropped.load(std::memory_order_relaxed), stats.callbackTime.snapshot()};
+    }
+
+    static uint64_t nowNs()
+    {
+        return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count());
+    }
+
+    static uint64_t nextInstanceId()
+    {
+        static std::atomic<uint64_t> next{1};
+        return next.fetch_add(1);
+    }
+
+    /**
+     * @brief The calling thread's counters for this handler. Only the first
+     *        signal from a thread takes a lock.
+     */
+    ProducerCounters &producerCounters()
+    {
+        struct Cached
+        {
+            uint64_t owner = 0;
+            ProducerCounters *counters = nullptr;
+        };
+        static thread_local Cached last;
+        static thread_local ThreadProducers all;
+
+        if (last.owner != _instanceId)
+        {
+            auto found = all.entries.find(_instanceId);
+            if (found == all.entries.end())
+            {
+                all.prune();
+                std::lock_guard<std::mutex> lock(_producers->mutex);
+                _producers->live.push_back(std::make_unique<ProducerCounters>());
+                found = all.entries.emplace(_instanceId, typename ThreadProducers::Entry{
+                    _producers, _producers->live.back().get()}).first;
+            }
+            last = Cached{_instanceId, found->second.counters};
+        }
+        return *last.counters;
+    }
+
+    /**
+     * @brief Bookkeeping for an item the queue accepted.
+     */
+    void countEnqueued()
+    {
+        auto &counter = producerCounters().enqueued;
+        counter.store(counter.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+
+        // Stamp the first item after each drain for the dispatch latency
+        if (_metricsEnabled.load(std::memory_order_relaxed) &&
+            _oldestPendingNs.load(std::memory_order_relaxed) == 0)
+        {
+            uint64_t expected = 0;
+            _oldestPendingNs.compare_exchange_strong(expected, nowNs(), std::memory_order_relaxed);
+        }
+    }
+
+    /**
+     * @brief A listener with its own cursor over the drained batches, used
+     *        by the PerListener and Pooled modes. Batches are shared, never
+     *        copied, between channels.
+     */
+    struct Channel
+    {
+        Listener item;        // Exactly one of item and batch is set
+        BatchListener batch;
+        ListenerStats stats;
+        std::mutex mutex;
+        std::condition_variable cv;
+        std::deque<std::shared_ptr<const Batch>> pending;
+        size_t pendingItems = 0;  // Items in pending
+        bool scheduled = false;  // Pooled: submitted to the executor
+        bool running = false;    // A callback is in progress
+        std::thread::id runner;  // Thread running the callback
+        std::atomic<bool> stop{false};
+        std::atomic<uint64_t> posted{0};
+        std::atomic<uint64_t> delivered{0};
+        std::thread thread;      // PerListener only
+    };
+
+    /**
+     * @brief Minimal fixed-size thread pool for the Pooled mode. A task is
+     *        a whole channel drain, so one shared task queue sees little
+     *        contention.
+     */
+    class Executor
+    {
+    public:
+        explicit Executor(size_t threads)
+        {
+            for (size_t i = 0; i < threads; ++i)
+            {
+                _threads.emplace_back(&Executor::run, this);
+            }
+        }
+
+        ~Executor()
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _stop = true;
+            }
+            _cv.notify_all();
+            for (auto &thread : _threads)
+            {
+                thread.join();
+            }
+        }
+
+        void submit(std::function<void()> task)
+        {
+            {
+                std::lock_guard<std::mutex> lock(_mutex);
+                _tasks.push_back(std::move(task));
+            }
+            _cv.notify_one();
+        }
+
+    private:
+        void run()
+        {
+            for (;;)
+            {
+                std::function<void()> task;
+                {
+                    std::unique_lock<std::mutex> lock(_mutex);
+                    _cv.wait(lock, [this] { return _stop || !_tasks.empty(); });
+                    if (_stop) return;
+                    task = std::move(_tasks.front());
+                    _tasks.pop_front();
+                }
+                task();
+            }
+        }
+
+        std::mutex _mutex;
+        std::condition_variable _cv;
+        std::deque<std::function<void()>> _tasks;
+        std::vector<std::thread> _threads;
+        bool _stop = false;
+    };
+
+    struct ListenerTable
+    {
+        std::map<int, Registered<Listener>> items;
+        std::map<int, Registered<BatchListener>> batches;
+        std::map<int, std::shared_ptr<Channel>> channels;
+    };
+    using ListenerSnapshot = std::shared_ptr<const ListenerTable>;
+
+    static constexpr uint64_t kIdle = UINT64_MAX;
+
+    /**
+     * @brief Replaces the listener table. Caller holds _listenersMutex.
+     * @return The version of the new table.
+     */
+    uint64_t publishListeners(std::shared_ptr<ListenerTable> listeners)
+    {
+        _listeners = std::move(listeners);
+        return _listenersVersion.fetch_add(1) + 1;
+    }
+
+    /**
+     * @brief Makes sure the worker's snapshot is the latest table. Only
+     *        takes _listenersMutex when the table changed since last time.
+     */
+    void refreshListeners(ListenerSnapshot &snapshot, uint64_t &version)
+    {
+        // Announce what we are about to use before checking for changes;
+        // pairs with unregisterListener() publishing and then waiting
+        setActiveVersion(version);
+        if (_listenersVersion.load() != version)
+        {
+            std::lock_guard<std::mutex> lock(_listenersMutex);
+            snapshot = _listeners;
+            version = _listenersVersion.load();
+            setActiveVersion(version);
+        }
+    }
+
+    /**
+     * @brief Publishes the table the worker is calling, or kIdle, and wakes
+     *        any unregisterListener() waiting for it.
+     */
+    void setActiveVersion(uint64_t version)
+    {
+        _activeVersion.store(version);
+        if (_versionWaiters.load() > 0)
         {
-            T data;
+            std::lock_guard<std::mutex> lock(_versionMutex);
+            _versionCV.notify_all();
+        }
+    }
+
+    std::shared_ptr<Channel> makeChannel(const Listener &item, const BatchListener &batch)
+    {
+        auto channel = std::make_shared<Channel>();
+        channel->item = item;
+        channel->batch = batch;
+        if (_mode == DispatchMode::PerListener)
+        {
+            channel->thread = std::thread(&DataHandler::runChannel, this, channel.get());
+        }
+        return channel;
+    }
+
+    /**
+     * @brief Appends a drained batch to a channel's backlog, applying the
+     *        setCapacity() bound to it.
+     */
+    void postToChannel(const std::shared_ptr<Channel> &channel, const std::shared_ptr<const Batch> &batch)
+    {
+        bool submit = false;
+        {
+            std::unique_lock<std::mutex> lock(channel->mutex);
+            auto overflows = [this, &channel, &batch] {
+                return _channelCapacity > 0 && channel->pendingItems > 0 &&
+                       channel->pendingItems + batch->size() > _channelCapacity;
+            };
+
+            if (overflows())
             {
-                std::unique_lock<std::mutex> lock(_cvMutex);
-                _condVar.wait(lock, [this] { return !_dataQueue.empty() || _stopFlag; });
-                if (_stopFlag && _dataQueue.empty()) {
+                switch (_channelPolicy)
+                {
+                case OverflowPolicy::Block:
+                    channel->cv.wait(lock, [&] { return !overflows() || channel->stop || _stopFlag; });
+                    if (_stopFlag) return;
+                    break;
+                case OverflowPolicy::DropNewest:
+                    channel->stats.dropped.fetch_add(batch->size(), std::memory_order_relaxed);
                     return;
+                case OverflowPolicy::DropOldest:
+                case OverflowPolicy::Conflate:
+                    while (overflows())
+                    {
+                        size_t dropped = channel->pending.front()->size();
+                        channel->pending.pop_front();
+                        channel->pendingItems -= dropped;
+                        channel->posted.fetch_sub(dropped);
+                        channel->stats.dropped.fetch_add(dropped, std::memory_order_relaxed);
+                    }
+                    break;
                 }
-                data = _dataQueue.front();
-                _dataQueue.pop();
             }
-            notifyListeners(data);
+
+            if (channel->stop) return;
+            channel->pending.push_back(batch);
+            channel->pendingItems += batch->size();
+            channel->posted.fetch_add(batch->size());
+            if (_mode == DispatchMode::Pooled && !channel->scheduled)
+            {
+                channel->scheduled = true;
+                submit = true;
+            }
+        }
+
+        if (_mode == DispatchMode::PerListener)
+        {
+            channel->cv.notify_all();
+        }
+        else if (submit)
+        {
+            // The task keeps the channel alive if it is unregistered meanwhile
+            _executor->submit([this, channel]() { runChannel(channel.get()); });
         }
     }
 
-    void notifyListeners(const T& data) 
+    /**
+     * @brief Delivers a channel's backlog in order. In PerListener mode this
+     *        is the channel's thread and waits for more; in Pooled mode it
+     *        returns once the backlog is empty.
+     */
+    void runChannel(Channel *channel)
     {
-        std::lock_guard<std::mutex> lock(_listenersMutex);
-        for (const auto &listener : _listeners) 
+        const bool pooled = _mode == DispatchMode::Pooled;
+        std::unique_lock<std::mutex> lock(channel->mutex);
+        for (;;)
         {
-            try
+            if (!pooled)
+            {
+                channel->cv.wait(lock, [channel] { return !channel->pending.empty() || channel->stop; });
+            }
+            if (channel->stop || channel->pending.empty())
             {
-                listener.second(data);
+                channel->scheduled = false;
+                return;
             }
-            catch(const std::exception& e)
+
+            std::shared_ptr<const Batch> batch = std::move(channel->pending.front());
+            channel->pending.pop_front();
+            channel->pendingItems -= batch->size();
+            channel->running = true;
+            channel->runner = std::this_thread::get_id();
+            lock.unlock();
+
+            if (channel->batch)
             {
-                std::cerr << "Listener threw an std::exception! " << e.what() << '\n';
+                invoke(channel->batch, *batch, channel->stats);
+                channel->delivered.fetch_add(batch->size());
             }
-            catch(...)
+            else
             {
-                std::cerr << "Listener threw an unknown exception!\n";
+                for (const auto &data : *batch)
+                {
+                    if (channel->stop) break;
+                    invoke(channel->item, DataStorage<T>::value(data), channel->stats);
+                    channel->delivered.fetch_add(1);
+                }
             }
+
+            lock.lock();
+            channel->running = false;
+            channel->cv.notify_all();
+        }
+    }
+
+    /**
+     * @brief Stops a channel. Once this returns its listener is not running
+     *        and will not be called again, unless called from that listener.
+     */
+    void stopChannel(const std::shared_ptr<Channel> &channel)
+    {
+        {
+            std::unique_lock<std::mutex> lock(channel->mutex);
+            channel->stop = true;
+            channel->cv.notify_all();
+            if (_mode == DispatchMode::Pooled)
+            {
+                channel->cv.wait(lock, [channel] {
+                    return !channel->running || channel->runner == std::this_thread::get_id();
+                });
+                return;
+            }
+        }
+
+        if (channel->thread.get_id() == std::this_thread::get_id())
+        {
+            // Unregistered from its own callback: join it later
+            std::lock_guard<std::mutex> lock(_retiredMutex);
+            _retired.push_back(channel);
+        }
+        else if (channel->thread.joinable())
+        {
+            channel->thread.join();
+        }
+    }
+
+    /**
+     * @brief Adds an item to the queue, waiting while a bounded backend is
+     *        full. Backends only consume args when they accept the item.
+     */
+    template <typename... Args>
+    void enqueue(Args&&... args)
+    {
+        if (_stopFlag) return;
+
+        if (_dataQueue.emplace(std::forward<Args>(args)...))
+        {
+            countEnqueued();
+            wakeWorker();
+            return;
+        }
+
+        // Full: wait for the worker to drain before each retry. Announcing
+        // ourselves before reading _drains means a drain either counts as
+        // new or sees us and notifies.
+        _blockedProducers.fetch_add(1);
+        for (;;)
+        {
+            uint64_t drains = _drains.load();
+            if (_dataQueue.emplace(std::forward<Args>(args)...))
+            {
+                countEnqueued();
+                break;
+            }
+            wakeWorker();
+
+            std::unique_lock<std::mutex> lock(_spaceMutex);
+            _spaceCV.wait(lock, [this, drains] { return _drains.load() != drains || _stopFlag; });
+            if (_stopFlag) break;
+        }
+        _blockedProducers.fetch_sub(1);
+        wakeWorker();
+    }
+
+    /**
+     * @brief Wakes the worker, but only if it is waiting for data.
+     *        Keeps the producer path free of locks and syscalls while the
+     *        worker is busy.
+     */
+    void wakeWorker()
+    {
+        // Pairs with the fence in processData(): either we see the worker
+        // sleeping, or the worker sees our item before it sleeps
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (_workerSleeping.load(std::memory_order_relaxed))
+        {
+            std::lock_guard<std::mutex> lock(_cvMutex);
+            _condVar.notify_one();
+        }
+    }
+
+    void processData() 
+    {
+        Batch batch;
+        while (!_stopFlag) 
+        {
+            // Take the stamp first: it then never belongs to a later batch
+            uint64_t oldest = _oldestPendingNs.exchange(0, std::memory_order_relaxed);
+            if (_dataQueue.popAll(batch))
+            {
+                if (oldest != 0)
+                {
+                    _dispatchLatency.record(nowNs() - oldest);
+                }
+                if (batch.size() > _highWaterMark.load(std::memory_order_relaxed))
+                {
+                    _highWaterMark.store(batch.size(), std::memory_order_relaxed);
+                }
+                _drained.fetch_add(batch.size());
+                _drains.fetch_add(1);
+                if (_blockedProducers.load() > 0)
+                {
+                    std::lock_guard<std::mutex> lock(_spaceMutex);
+                    _spaceCV.notify_all();
+                }
+                if (_mode == DispatchMode::Serial)
+                {
+                    notifyListeners(batch);
+                }
+                else
+                {
+                    postBatch(batch);
+                }
+                batch.clear();
+                continue;
+            }
+
+            std::unique_lock<std::mutex> lock(_cvMutex);
+            _workerSleeping.store(true, std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            _condVar.wait(lock, [this] { return !_dataQueue.empty() || _stopFlag; });
+            _workerSleeping.store(false, std::memory_order_relaxed);
+        }
+    }
+
+    void notifyListeners(const Batch& batch) 
+    {
+        // The snapshot is refreshed between items, so changes made by a
+        // callback apply from the next item on
+        for (const auto &data : batch)
+        {
+            refreshListeners(_snapshot, _snapshotVersion);
+            for (const auto &listener : _snapshot->items) 
+            {
+                invoke(listener.second.function, DataStorage<T>::value(data), *listener.second.stats);
+            }
+            _dispatched.fetch_add(1);
+        }
+
+        refreshListeners(_snapshot, _snapshotVersion);
+        for (const auto &listener : _snapshot->batches)
+        {
+            invoke(listener.second.function, batch, *listener.second.stats);
+        }
+        setActiveVersion(kIdle);
+    }
+
+    void postBatch(Batch& batch)
+    {
+        refreshListeners(_snapshot, _snapshotVersion);
+        setActiveVersion(kIdle);
+
+        auto shared = std::make_shared<const Batch>(std::move(batch));
+        for (const auto &channel : _snapshot->channels)
+        {
+            postToChannel(channel.second, shared);
+        }
+        _dispatched.fetch_add(shared->size());
+    }
+
+    template <typename Function, typename Arg>
+    void invoke(const Function& listener, const Arg& arg, ListenerStats& stats)
+    {
+        bool timed = _metricsEnabled.load(std::memory_order_relaxed);
+        uint64_t start = timed ? nowNs() : 0;
+        try
+        {
+            listener(arg);
+        }
+        catch(const std::exception& e)
+        {
+            stats.exceptions.store(stats.exceptions.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            std::cerr << "Listener threw an std::exception! " << e.what() << '\n';
+        }
+        catch(...)
+        {
+            stats.exceptions.store(stats.exceptions.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+            std::cerr << "Listener threw an unknown exception!\n";
+        }
+        if (timed)
+        {
+            stats.callbackTime.record(nowNs() - start);
         }
     }
 
-    std::mutex _listenersMutex;
-    std::map<int, Listener> _listeners;
+    const DispatchMode _mode;
+    const uint64_t _instanceId = nextInstanceId();
+    const std::shared_ptr<ProducerRegistry> _producers = std::make_shared<ProducerRegistry>();
+    std::atomic<bool> _metricsEnabled{false};
+    std::atomic<uint64_t> _oldestPendingNs{0};  // Enqueue time of the oldest undrained item, or 0
+    std::atomic<size_t> _highWaterMark{0};
+    LatencyHistogram _dispatchLatency;  // Worker thread only writes
+    std::unique_ptr<Executor> _executor;  // Pooled mode only
+    std::mutex _retiredMutex;
+    std::vector<std::shared_ptr<Channel>> _retired;  // Channels that unregistered themselves
+    std::atomic<uint64_t> _drained{0};     // Items taken from the queue
+    std::atomic<uint64_t> _dispatched{0};  // Items handed to all listeners
+    std::mutex _listenersMutex;  // Serializes changes to _listeners
+    ListenerSnapshot _listeners = std::make_shared<const ListenerTable>();
+    std::atomic<uint64_t> _listenersVersion{0};
+    std::atomic<uint64_t> _activeVersion{kIdle};  // Table the worker is calling, or kIdle
+    std::atomic<int> _versionWaiters{0};
+    std::mutex _versionMutex;
+    std::condition_variable _versionCV;  // Signaled when _activeVersion changes and someone waits
+    ListenerSnapshot _snapshot = _listeners;  // Worker thread only
+    uint64_t _snapshotVersion = 0;
     int nextListenerId_ = 123;
-    std::queue<T> _dataQueue;
+    Queue _dataQueue;
     std::mutex _cvMutex;
     std::condition_variable _condVar;
+    std::atomic<bool> _workerSleeping{false};
+    std::mutex _spaceMutex;
+    std::condition_variable _spaceCV;  // Signaled after a drain when producers are blocked
+    std::atomic<uint64_t> _drains{0};
+    std::atomic<int> _blockedProducers{0};
     std::thread _workerThread;
     std::atomic<bool> _stopFlag;
+    size_t _channelCapacity = 0;  // See setCapacity()
+    OverflowPolicy _channelPolicy = OverflowPolicy::Block;
 };
 }
 
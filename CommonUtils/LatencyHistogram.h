@@ -0,0 +1,97 @@
+#ifndef COMMONUTILS_LATENCYHISTOGRAM_H
+#define COMMONUTILS_LATENCYHISTOGRAM_H
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+namespace CommonUtils
+{
+/**
+ * @class LatencyHistogram
+ * @brief Log2-bucketed histogram of durations in nanoseconds.
+ *        * Meant to be recorded into by one thread at a time; record() only
+ *          uses relaxed loads and stores, never read-modify-write.
+ *        * Any thread may take a snapshot() concurrently.
+ */
+class LatencyHistogram {
+public:
+    /// Bucket i counts durations in [2^i, 2^(i+1)) ns; bucket 0 also holds 0
+    static constexpr size_t kBuckets = 40;
+
+    /**
+     * @brief Point-in-time copy of a histogram.
+     */
+    struct Snapshot
+    {
+        std::array<uint64_t, kBuckets> buckets{};
+        uint64_t count = 0;
+        uint64_t totalNs = 0;
+        uint64_t maxNs = 0;
+
+        /**
+         * @brief Upper bound of the bucket holding the given percentile.
+         * @param percentile In [0, 100].
+         */
+        uint64_t percentileNs(double percentile) const
+        {
+            if (count == 0) return 0;
+            auto target = static_cast<uint64_t>(static_cast<double>(count) * percentile / 100.0);
+            uint64_t seen = 0;
+            for (size_t i = 0; i < kBuckets; ++i)
+            {
+                seen += buckets[i];
+                if (seen > target || seen == count)
+                {
+                    return (uint64_t{1} << (i + 1)) - 1;
+                }
+            }
+            return maxNs;
+        }
+    };
+
+    void record(uint64_t ns)
+    {
+        size_t bucket = 0;
+        for (uint64_t v = ns >> 1; v != 0 && bucket < kBuckets - 1; v >>= 1)
+        {
+            ++bucket;
+        }
+
+        bump(_buckets[bucket], 1);
+        bump(_count, 1);
+        bump(_totalNs, ns);
+        if (ns > _maxNs.load(std::memory_order_relaxed))
+        {
+            _maxNs.store(ns, std::memory_order_relaxed);
+        }
+    }
+
+    Snapshot snapshot() const
+    {
+        Snapshot result;
+        for (size_t i = 0; i < kBuckets; ++i)
+        {
+            result.buckets[i] = _buckets[i].load(std::memory_order_relaxed);
+        }
+        result.count = _count.load(std::memory_order_relaxed);
+        result.totalNs = _totalNs.load(std::memory_order_relaxed);
+        result.maxNs = _maxNs.load(std::memory_order_relaxed);
+        return result;
+    }
+
+private:
+    // Single writer: a plain load and store is enough and avoids a locked op
+    static void bump(std::atomic<uint64_t> &counter, uint64_t by)
+    {
+        counter.store(counter.load(std::memory_order_relaxed) + by, std::memory_order_relaxed);
+    }
+
+    std::array<std::atomic<uint64_t>, kBuckets> _buckets{};
+    std::atomic<uint64_t> _count{0};
+    std::atomic<uint64_t> _totalNs{0};
+    std::atomic<uint64_t> _maxNs{0};
+};
+}
+
+#endif // COMMONUTILS_LATENCYHISTOGRAM_H
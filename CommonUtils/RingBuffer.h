@@ -0,0 +1,211 @@
+#ifndef COMMONUTILS_RINGBUFFER_H
+#define COMMONUTILS_RINGBUFFER_H
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace CommonUtils
+{
+/**
+ * @brief Number of threads allowed to push into a RingBuffer concurrently.
+ */
+enum class ProducerMode
+{
+    Single,  ///< Exactly one producer thread (SPSC)
+    Multi    ///< Any number of producer threads (MPSC)
+};
+
+/**
+ * @class RingBuffer
+ * @brief Bounded, lock-free queue with a single consumer.
+ *        * Each slot carries a sequence number, so producers and the consumer
+ *          never touch a lock and never allocate after construction.
+ *        * In ProducerMode::Multi producers claim slots with a CAS on the
+ *          tail; in ProducerMode::Single the tail is a plain store.
+ *        * Head and tail live on separate cache lines.
+ *
+ *        Can be used as the queue backend of DataHandler.
+ *
+ * @tparam T        Stored type; must be move constructible.
+ * @tparam Capacity Number of slots; must be a power of two.
+ * @tparam Mode     Producer concurrency, selected at compile time.
+ */
+template <typename T, size_t Capacity = 16384, ProducerMode Mode = ProducerMode::Multi>
+class RingBuffer {
+    static_assert(Capacity >= 2 && (Capacity & (Capacity - 1)) == 0,
+                  "RingBuffer capacity must be a power of two");
+
+public:
+    RingBuffer() : _cells(new Cell[Capacity])
+    {
+        for (size_t i = 0; i < Capacity; ++i)
+        {
+            _cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    ~RingBuffer()
+    {
+        T discarded;
+        while (pop(discarded))
+        {
+        }
+    }
+
+    RingBuffer(const RingBuffer &) = delete;
+    RingBuffer &operator=(const RingBuffer &) = delete;
+
+    /**
+     * @brief Adds an item to the back of the buffer.
+     * @return false if the buffer is full; the item is left untouched.
+     */
+    template <typename U>
+    bool push(U &&item)
+    {
+        return emplace(std::forward<U>(item));
+    }
+
+    /**
+     * @brief Constructs an item in place at the back of the buffer.
+     * @return false if the buffer is full; the arguments are left untouched.
+     */
+    template <typename... Args>
+    bool emplace(Args &&... args)
+    {
+        size_t pos = _tail.load(std::memory_order_relaxed);
+        Cell *cell;
+
+        if constexpr (Mode == ProducerMode::Single)
+        {
+            cell = &_cells[pos & kMask];
+            if (cell->sequence.load(std::memory_order_acquire) != pos)
+            {
+                return false;
+            }
+            _tail.store(pos + 1, std::memory_order_relaxed);
+        }
+        else
+        {
+            for (;;)
+            {
+                cell = &_cells[pos & kMask];
+                size_t sequence = cell->sequence.load(std::memory_order_acquire);
+                auto diff = static_cast<std::intptr_t>(sequence) - static_cast<std::intptr_t>(pos);
+                if (diff == 0)
+                {
+                    if (_tail.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+                    {
+                        break;
+                    }
+                }
+                else if (diff < 0)
+                {
+                    return false;
+                }
+                else
+                {
+                    pos = _tail.load(std::memory_order_relaxed);
+                }
+            }
+        }
+
+        new (&cell->storage) T(std::forward<Args>(args)...);
+        cell->sequence.store(pos + 1, std::memory_order_release);
+        return true;
+    }
+
+    /**
+     * @brief Moves the front item out of the buffer. Consumer thread only.
+     * @return false if the buffer is empty.
+     */
+    bool pop(T &out)
+    {
+        size_t pos = _head.load(std::memory_order_relaxed);
+        Cell &cell = _cells[pos & kMask];
+        if (cell.sequence.load(std::memory_order_acquire) != pos + 1)
+        {
+            return false;
+        }
+
+        T *item = std::launder(reinterpret_cast<T*>(&cell.storage));
+        out = std::move(*item);
+        item->~T();
+
+        cell.sequence.store(pos + Capacity, std::memory_order_release);
+        _head.store(pos + 1, std::memory_order_relaxed);
+        return true;
+    }
+
+    /**
+     * @brief Moves every item that is ready into out. Consumer thread only.
+     *        Stops after one full ring so busy producers cannot keep the
+     *        consumer here forever.
+     * @return false if the buffer is empty.
+     */
+    template <typename Container>
+    bool popAll(Container &out)
+    {
+        size_t pos = _head.load(std::memory_order_relaxed);
+        size_t start = pos;
+        while (pos - start < Capacity)
+        {
+            Cell &cell = _cells[pos & kMask];
+            if (cell.sequence.load(std::memory_order_acquire) != pos + 1)
+            {
+                break;
+            }
+
+            T *item = std::launder(reinterpret_cast<T*>(&cell.storage));
+            out.push_back(std::move(*item));
+            item->~T();
+
+            cell.sequence.store(pos + Capacity, std::memory_order_release);
+            ++pos;
+            _head.store(pos, std::memory_order_relaxed);
+        }
+        return pos != start;
+    }
+
+    /**
+     * @brief True if no item is ready for the consumer.
+     */
+    bool empty() const
+    {
+        size_t pos = _head.load(std::memory_order_relaxed);
+        return _cells[pos & kMask].sequence.load(std::memory_order_acquire) != pos + 1;
+    }
+
+    /**
+     * @brief Approximate number of queued items; exact when quiescent.
+     */
+    size_t size() const
+    {
+        size_t head = _head.load(std::memory_order_relaxed);
+        size_t tail = _tail.load(std::memory_order_relaxed);
+        return tail > head ? tail - head : 0;
+    }
+
+    static constexpr size_t capacity() { return Capacity; }
+
+private:
+    static constexpr size_t kMask = Capacity - 1;
+    static constexpr size_t kCacheLine = 64;
+
+    struct Cell
+    {
+        std::atomic<size_t> sequence;
+        typename std::aligned_storage<sizeof(T), alignof(T)>::type storage;
+    };
+
+    std::unique_ptr<Cell[]> _cells;
+    alignas(kCacheLine) std::atomic<size_t> _tail{0};  // Next slot for producers
+    alignas(kCacheLine) std::atomic<size_t> _head{0};  // Next slot for the consumer
+    char _padding[kCacheLine - sizeof(std::atomic<size_t>)];
+};
+}
+
+#endif // COMMONUTILS_RINGBUFFER_H
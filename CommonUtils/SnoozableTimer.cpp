@@ -1,8 +1,39 @@
 #include "SnoozableTimer.h"
 
-SnoozableTimer::SnoozableTimer(std::function<void ()> ahFunciont, int anSnoozePeriodMs)
+#include <climits>
+
+namespace
+{
+using Clock = CommonUtils::TimerService::Clock;
+
+constexpr int64_t kDisarmedNs = INT64_MIN;
+
+int64_t nowNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(Clock::now().time_since_epoch()).count();
+}
+
+int64_t deadlineNs(int anPeriodMs)
+{
+    return nowNs() + int64_t{anPeriodMs} * 1000000;
+}
+
+Clock::time_point timeOf(int64_t anDeadlineNs)
+{
+    return Clock::time_point(std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(anDeadlineNs)));
+}
+}
+
+SnoozableTimer::SnoozableTimer(std::function<void ()> ahFunciont, int anSnoozePeriodMs,
+                               CommonUtils::TimerService &ahService)
     : mhFunction(ahFunciont)
+    , mhService(ahService)
+    , mnDeadlineNs(kDisarmedNs)
     , mnSnoozePeriodMs(anSnoozePeriodMs)
+    , mnTimerId(0)
+    , mnFiringId(0)
+    , mnScheduledNs(0)
+    , mbArmed(false)
     , mbIsRunning(false)
 {
 
@@ -15,61 +46,111 @@ SnoozableTimer::~SnoozableTimer()
 
 void SnoozableTimer::start()
 {
+    std::lock_guard<std::mutex> lock(mcMutex);
     if (mbIsRunning) return;
 
-    mcExecutionTime = std::chrono::high_resolution_clock::now() +
-                      std::chrono::milliseconds(mnSnoozePeriodMs);
-
     mbIsRunning = true;
-    mcThread = std::thread([this]()
-    {
-        std::unique_lock<std::mutex> lock(mcMutex);
-
-        while (mbIsRunning)
-        {
-            // Wait until execution time or until notified
-            if (mcCv.wait_until(lock, mcExecutionTime) == std::cv_status::timeout && mbIsRunning)
-            {
-                lock.unlock();
-                mhFunction();
-                lock.lock();
-                // This should prevent reexecution until we hit the snooze!
-                mcExecutionTime = std::chrono::high_resolution_clock::now() +
-                                  std::chrono::hours(87600);
-            }
-        }
-    });
+    int64_t lnDeadlineNs = deadlineNs(mnSnoozePeriodMs.load(std::memory_order_relaxed));
+    mnDeadlineNs.store(lnDeadlineNs);
+    arm(lnDeadlineNs);
 }
 
 void SnoozableTimer::stop()
 {
+    CommonUtils::TimerService::TimerId lnTimerId;
+    CommonUtils::TimerService::TimerId lnFiringId;
     {
         std::lock_guard<std::mutex> lock(mcMutex);
         mbIsRunning = false;
+        mbArmed = false;
+        mnDeadlineNs.store(kDisarmedNs);
+        lnTimerId = mnTimerId;
+        lnFiringId = mnFiringId;
+        mnTimerId = 0;
+        mnFiringId = 0;
     }
 
-    mcCv.notify_all();
-
-    if (mcThread.joinable())
+    // Outside the lock: these wait for a running callback, which may snooze
+    if (lnTimerId != 0)
     {
-        mcThread.join();
+        mhService.cancel(lnTimerId);
+    }
+    if (lnFiringId != 0 && lnFiringId != lnTimerId)
+    {
+        mhService.cancel(lnFiringId);
     }
 }
 
 void SnoozableTimer::snooze()
 {
-    std::lock_guard<std::mutex> lock(mcMutex);
-    auto lcTimeNow = std::chrono::high_resolution_clock::now() +
-            std::chrono::milliseconds(mnSnoozePeriodMs);
-    mcExecutionTime = lcTimeNow;
-    mcCv.notify_all(); // Notify to re-evaluate the wait condition
+    // Hot path: one exchange. Only a timer that already fired needs the lock.
+    int64_t lnDeadlineNs = deadlineNs(mnSnoozePeriodMs.load(std::memory_order_relaxed));
+    if (mnDeadlineNs.exchange(lnDeadlineNs, std::memory_order_acq_rel) == kDisarmedNs)
+    {
+        rearm();
+    }
 }
 
 void SnoozableTimer::updateSnoozePeriod(int anSnoozePeriodMs)
 {
+    mnSnoozePeriodMs.store(anSnoozePeriodMs, std::memory_order_relaxed);
+    int64_t lnDeadlineNs = deadlineNs(anSnoozePeriodMs);
+    mnDeadlineNs.store(lnDeadlineNs);
+
+    // A shorter period can move the deadline before the next check
+    std::lock_guard<std::mutex> lock(mcMutex);
+    if (!mbIsRunning) return;
+
+    if (!mbArmed)
     {
-        std::lock_guard<std::mutex> lock(mcMutex);
-        mnSnoozePeriodMs = anSnoozePeriodMs;
+        arm(lnDeadlineNs);
+    }
+    else if (lnDeadlineNs < mnScheduledNs)
+    {
+        mnScheduledNs = lnDeadlineNs;
+        mhService.reschedule(mnTimerId, timeOf(lnDeadlineNs));
+    }
+}
+
+void SnoozableTimer::expire()
+{
+    std::unique_lock<std::mutex> lock(mcMutex);
+    if (!mbIsRunning || !mbArmed) return;
+    mbArmed = false;
+
+    // Snoozed since this check was scheduled: check again at the new deadline.
+    // A failed exchange loads the deadline a concurrent snooze just stored.
+    int64_t lnDeadlineNs = mnDeadlineNs.load();
+    if (lnDeadlineNs > nowNs() ||
+        !mnDeadlineNs.compare_exchange_strong(lnDeadlineNs, kDisarmedNs))
+    {
+        arm(lnDeadlineNs);
+        return;
+    }
+
+    // Keep the ID so stop() still waits for the function if a snooze re-arms
+    mnFiringId = mnTimerId;
+    lock.unlock();
+    mhFunction();
+    lock.lock();
+    mnFiringId = 0;
+}
+
+void SnoozableTimer::arm(int64_t anDeadlineNs)
+{
+    mbArmed = true;
+    mnScheduledNs = anDeadlineNs;
+    mnTimerId = mhService.schedule(timeOf(anDeadlineNs), [this]() { expire(); });
+}
+
+void SnoozableTimer::rearm()
+{
+    std::lock_guard<std::mutex> lock(mcMutex);
+    if (!mbIsRunning || mbArmed) return;
+
+    int64_t lnDeadlineNs = mnDeadlineNs.load();
+    if (lnDeadlineNs != kDisarmedNs)
+    {
+        arm(lnDeadlineNs);
     }
-    snooze();
 }
@@ -1,17 +1,21 @@
 #ifndef SNOOZABLETIMER_H
 #define SNOOZABLETIMER_H
 
+#include <atomic>
+#include <cstdint>
 #include <functional>
 #include <chrono>
-#include <condition_variable>
 #include <mutex>
-#include <thread>
+#include "TimerService.h"
 
 /**
  * @class SnoozableTimer
  * @brief This class will execute an std::function after a snooze period
  *        of milliseconds once it is started.  It's key feature is a 'snooze'
  *        method that will increase the time until execution.
+ *        The function runs on the thread of a CommonUtils::TimerService.
+ *        snooze() only moves an atomic deadline; the service is not woken
+ *        and looks at the deadline again when its previous wait expires.
  */
 class SnoozableTimer
 {
@@ -21,8 +25,10 @@ public:
      * @brief Constructor
      * @param func
      * @param anTimeoutMs
+     * @param ahService Service that runs the timer
      */
-    SnoozableTimer(std::function<void()> ahFunciont, int anSnoozePeriodMs );
+    SnoozableTimer(std::function<void()> ahFunciont, int anSnoozePeriodMs,
+                   CommonUtils::TimerService &ahService = CommonUtils::TimerService::instance());
 
     /**
      * @brief Destructor
@@ -40,7 +46,8 @@ public:
     void stop();
 
     /**
-     * @brief noozes until NOW plus the snooze time
+     * @brief noozes until NOW plus the snooze time.
+     *        Lock-free; safe to call from any number of threads.
      */
     void snooze();
 
@@ -52,12 +59,19 @@ public:
     void updateSnoozePeriod(int anSnoozePeriodMs);
 
 private:
+    void expire();
+    void arm(int64_t anDeadlineNs);
+    void rearm();
+
     std::function<void()> mhFunction;
-    std::chrono::high_resolution_clock::time_point mcExecutionTime;
-    mutable std::mutex mcMutex;
-    std::condition_variable mcCv;
-    std::thread mcThread;
-    int mnSnoozePeriodMs;
+    CommonUtils::TimerService &mhService;
+    std::atomic<int64_t> mnDeadlineNs;    // Steady clock; disarmed once fired or stopped
+    std::atomic<int> mnSnoozePeriodMs;
+    mutable std::mutex mcMutex;           // Guards everything below
+    CommonUtils::TimerService::TimerId mnTimerId;
+    CommonUtils::TimerService::TimerId mnFiringId;
+    int64_t mnScheduledNs;                // When the service will next check
+    bool mbArmed;
     bool mbIsRunning;
 };
 
@@ -3,68 +3,29 @@
 namespace CommonUtils
 {
 
-Timer::Timer() : _isRunning(false)
+Timer::Timer(TimerService &service) : _service(service), _id(0)
 {
 
 }
 
 void Timer::startOneShot(std::function<void ()> func, unsigned int interval)
 {
-    if (_isRunning)
-    {
-        stop();
-    }
-    _isRunning = true;
-    _thread = std::thread([this, func, interval]()
-    {
-        std::unique_lock<std::mutex> lock(_mutex);
-        if (_cv.wait_for(lock, std::chrono::milliseconds(interval), [this]() { return !_isRunning; }))
-        {
-            return;
-        }
-        if (_isRunning)
-        {
-            func();
-        }
-        _isRunning = false;
-    });
+    stop();
+    _id = _service.schedule(TimerService::Clock::now() + std::chrono::milliseconds(interval), std::move(func));
 }
 
 void Timer::startPeriodic(std::function<void ()> func, unsigned int interval)
 {
-    if (_isRunning)
-    {
-        stop();
-    }
-    _isRunning = true;
-    _thread = std::thread([this, func, interval]()
-    {
-        while (_isRunning)
-        {
-            std::unique_lock<std::mutex> lock(_mutex);
-            if (_cv.wait_for(lock, std::chrono::milliseconds(interval), [this]() { return !_isRunning; }))
-            {
-                return;
-            }
-            if (_isRunning)
-            {
-                func();
-            }
-        }
-    });
+    stop();
+    _id = _service.schedulePeriodic(std::chrono::milliseconds(interval), std::move(func));
 }
 
 void Timer::stop()
 {
+    TimerService::TimerId id = _id.exchange(0);
+    if (id != 0)
     {
-        std::lock_guard<std::mutex> lock(_mutex);
-        _isRunning = false;
-    }
-
-    _cv.notify_all();
-    if (_thread.joinable())
-    {
-        _thread.join();
+        _service.cancel(id);
     }
 }
 
@@ -1,12 +1,9 @@
 #ifndef COMMONUTILS_TIMER_H
 #define COMMONUTILS_TIMER_H
 
-#include <iostream>
-#include <thread>
 #include <functional>
 #include <atomic>
-#include <chrono>
-#include <condition_variable>
+#include "TimerService.h"
 
 namespace CommonUtils
 {
@@ -15,13 +12,16 @@ namespace CommonUtils
  * @brief Implements a simple timer that can execute a function after a
  *         specified amount of time, or periodically.  Designed for easy
  *         cancellation and destruction.
+ *         The function runs on the thread of a TimerService, shared by all
+ *         timers of that service.
  */
 class Timer {
 public:
     /**
      * @brief Constructor for a cancelable timer.
+     * @param service - Service that runs the timer
      */
-    Timer();
+    explicit Timer(TimerService &service = TimerService::instance());
 
     /**
      *  Destructor - Cancels any pending behavior
@@ -44,15 +44,14 @@ public:
     void startPeriodic(std::function<void()> func, unsigned int interval);
 
     /**
-     * @brief Cancells the timer.
+     * @brief Cancells the timer. Once this returns the function is not
+     *        running, unless stop() was called from it.
      */
     void stop();
 
 private:
-    std::atomic<bool> _isRunning;
-    std::thread _thread;
-    std::mutex _mutex;
-    std::condition_variable _cv;
+    TimerService &_service;
+    std::atomic<TimerService::TimerId> _id;
 };
 
 }
@@ -0,0 +1,378 @@
+#include "TimerService.h"
+
+namespace CommonUtils
+{
+
+TimerService::TimerService(std::chrono::milliseconds tick) :
+    _tick(tick.count() > 0 ? Clock::duration(tick) : Clock::duration(std::chrono::milliseconds(1))),
+    _start(Clock::now())
+{
+    _thread = std::thread([this]() { run(); });
+}
+
+TimerService::~TimerService()
+{
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _cv.notify_all();
+    if (_thread.joinable())
+    {
+        _thread.join();
+    }
+}
+
+TimerService &TimerService::instance()
+{
+    // Never destroyed: handles owned by other statics may outlive it
+    static TimerService *service = new TimerService();
+    return *service;
+}
+
+TimerService::TimerId TimerService::schedule(Clock::time_point deadline, std::function<void()> func)
+{
+    return add(tickFor(deadline), 0, std::move(func));
+}
+
+TimerService::TimerId TimerService::schedulePeriodic(std::chrono::milliseconds interval, std::function<void()> func)
+{
+    uint64_t ticks = tickFor(_start + interval);
+    if (ticks == 0)
+    {
+        ticks = 1;
+    }
+    return add(tickFor(Clock::now() + interval), ticks, std::move(func));
+}
+
+bool TimerService::cancel(TimerId id)
+{
+    // Destroyed after the lock is released, the function may own a handle
+    std::function<void()> discarded;
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    bool found = false;
+    auto it = _entries.find(id);
+    if (it != _entries.end())
+    {
+        if (it->second.list)
+        {
+            unlink(it->second);
+        }
+        discarded = std::move(it->second.func);
+        _entries.erase(it);
+        found = true;
+    }
+
+    if (_runningId == id && std::this_thread::get_id() != _thread.get_id())
+    {
+        _idleCV.wait(lock, [this, id]() { return _runningId != id; });
+    }
+    return found;
+}
+
+bool TimerService::reschedule(TimerId id, Clock::time_point deadline)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto it = _entries.find(id);
+    if (it == _entries.end())
+    {
+        return false;
+    }
+
+    Entry &entry = it->second;
+    entry.expiry = tickFor(deadline);
+    if (entry.firing)
+    {
+        // run() files it again, with its function, when the callback returns
+        entry.rescheduled = true;
+        return true;
+    }
+
+    if (entry.list)
+    {
+        unlink(entry);
+    }
+    insert(entry);
+    wakeIfEarlier(entry.expiry);
+    return true;
+}
+
+size_t TimerService::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _entries.size();
+}
+
+TimerService::TimerId TimerService::add(uint64_t expiry, uint64_t interval, std::function<void()> func)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    TimerId id = _nextId++;
+    Entry &entry = _entries[id];
+    entry.id = id;
+    entry.expiry = expiry;
+    entry.interval = interval;
+    entry.func = std::move(func);
+    insert(entry);
+    wakeIfEarlier(expiry);
+    return id;
+}
+
+uint64_t TimerService::tickFor(Clock::time_point deadline) const
+{
+    if (deadline <= _start)
+    {
+        return 0;
+    }
+
+    auto elapsed = deadline - _start;
+    if (elapsed >= Clock::duration::max() - _tick)
+    {
+        return kNever - 1;
+    }
+
+    // Round up so a timer never fires before its deadline
+    return static_cast<uint64_t>((elapsed + _tick - Clock::duration(1)) / _tick);
+}
+
+TimerService::Clock::time_point TimerService::timeOf(uint64_t tick) const
+{
+    return _start + _tick * static_cast<Clock::rep>(tick);
+}
+
+void TimerService::insert(Entry &entry)
+{
+    if (entry.expiry <= _currentTick)
+    {
+        // Already due: append so timers run in expiry order
+        entry.list = &_due;
+        entry.next = nullptr;
+        entry.prev = _dueTail;
+        if (_dueTail)
+        {
+            _dueTail->next = &entry;
+        }
+        else
+        {
+            _due = &entry;
+        }
+        _dueTail = &entry;
+        return;
+    }
+
+    // File under the most significant slot group in which the expiry differs
+    // from the current tick; it moves down a level each time that slot comes up
+    uint64_t diff = entry.expiry ^ _currentTick;
+    size_t level = 0;
+    uint64_t slot;
+    if (diff >> (kSlotBits * kLevels))
+    {
+        // Beyond the wheel: park in the top-level slot visited last and re-file then
+        level = kLevels - 1;
+        slot = ((_currentTick >> (kSlotBits * level)) + kSlotMask) & kSlotMask;
+    }
+    else
+    {
+        while (level < kLevels - 1 && (diff >> (kSlotBits * (level + 1))))
+        {
+            ++level;
+        }
+        slot = (entry.expiry >> (kSlotBits * level)) & kSlotMask;
+    }
+
+    Entry *&head = _wheel[level][slot];
+    entry.list = &head;
+    entry.prev = nullptr;
+    entry.next = head;
+    if (head)
+    {
+        head->prev = &entry;
+    }
+    head = &entry;
+}
+
+void TimerService::unlink(Entry &entry)
+{
+    if (entry.prev)
+    {
+        entry.prev->next = entry.next;
+    }
+    else
+    {
+        *entry.list = entry.next;
+    }
+
+    if (entry.next)
+    {
+        entry.next->prev = entry.prev;
+    }
+    else if (entry.list == &_due)
+    {
+        _dueTail = entry.prev;
+    }
+
+    entry.prev = nullptr;
+    entry.next = nullptr;
+    entry.list = nullptr;
+}
+
+void TimerService::catchUp(uint64_t nowTick)
+{
+    // Jump straight between ticks that have something to do
+    while (_currentTick < nowTick)
+    {
+        uint64_t next = nextWheelTick();
+        if (next > nowTick)
+        {
+            _currentTick = nowTick;
+            return;
+        }
+        _currentTick = next - 1;
+        advance();
+    }
+}
+
+void TimerService::advance()
+{
+    ++_currentTick;
+
+    // Higher levels first: their entries may land in the lower slots due now
+    for (size_t level = kLevels - 1; level > 0; --level)
+    {
+        uint64_t below = (uint64_t{1} << (kSlotBits * level)) - 1;
+        if ((_currentTick & below) == 0)
+        {
+            cascade(level);
+        }
+    }
+
+    Entry *entry = _wheel[0][_currentTick & kSlotMask];
+    _wheel[0][_currentTick & kSlotMask] = nullptr;
+    while (entry)
+    {
+        Entry *next = entry->next;
+        insert(*entry);
+        entry = next;
+    }
+}
+
+void TimerService::cascade(size_t level)
+{
+    uint64_t slot = (_currentTick >> (kSlotBits * level)) & kSlotMask;
+    Entry *entry = _wheel[level][slot];
+    _wheel[level][slot] = nullptr;
+    while (entry)
+    {
+        Entry *next = entry->next;
+        insert(*entry);
+        entry = next;
+    }
+}
+
+uint64_t TimerService::nextWheelTick() const
+{
+    // Every entry on a level expires before any entry on the level above
+    for (size_t level = 0; level < kLevels; ++level)
+    {
+        unsigned shift = kSlotBits * static_cast<unsigned>(level);
+        uint64_t index = _currentTick >> shift;
+        uint64_t ahead = level == kLevels - 1 ? kSlots : kSlots - (index & kSlotMask);
+        for (uint64_t k = 1; k < ahead; ++k)
+        {
+            if (_wheel[level][(index + k) & kSlotMask])
+            {
+                return (index + k) << shift;
+            }
+        }
+    }
+    return kNever;
+}
+
+void TimerService::wakeIfEarlier(uint64_t expiry)
+{
+    if (expiry < _sleepUntil)
+    {
+        _cv.notify_one();
+    }
+}
+
+void TimerService::run()
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+    while (!_stop)
+    {
+        _sleepUntil = 0;
+        catchUp(static_cast<uint64_t>((Clock::now() - _start) / _tick));
+
+        while (_due && !_stop)
+        {
+            Entry &entry = *_due;
+            unlink(entry);
+
+            TimerId id = entry.id;
+            uint64_t interval = entry.interval;
+            std::function<void()> func = std::move(entry.func);
+            if (interval == 0)
+            {
+                _entries.erase(id);
+            }
+            else
+            {
+                entry.firing = true;
+                entry.rescheduled = false;
+            }
+
+            _runningId = id;
+            lock.unlock();
+            func();
+            lock.lock();
+            _runningId = 0;
+
+            bool rearmed = false;
+            if (interval != 0)
+            {
+                auto it = _entries.find(id);
+                // Not re-armed if cancelled from the callback
+                if (it != _entries.end())
+                {
+                    Entry &periodic = it->second;
+                    periodic.firing = false;
+                    periodic.func = std::move(func);
+                    if (!periodic.rescheduled)
+                    {
+                        periodic.expiry = tickFor(Clock::now()) + interval;
+                    }
+                    insert(periodic);
+                    rearmed = true;
+                }
+            }
+            _idleCV.notify_all();
+
+            if (!rearmed)
+            {
+                lock.unlock();
+                func = nullptr;
+                lock.lock();
+            }
+
+            catchUp(static_cast<uint64_t>((Clock::now() - _start) / _tick));
+        }
+
+        if (_stop)
+        {
+            break;
+        }
+
+        _sleepUntil = nextWheelTick();
+        if (_sleepUntil == kNever)
+        {
+            _cv.wait(lock);
+        }
+        else
+        {
+            _cv.wait_until(lock, timeOf(_sleepUntil));
+        }
+    }
+}
+
+}
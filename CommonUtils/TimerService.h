@@ -0,0 +1,142 @@
+#ifndef COMMONUTILS_TIMERSERVICE_H
+#define COMMONUTILS_TIMERSERVICE_H
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+
+namespace CommonUtils
+{
+/**
+ * @class TimerService
+ * @brief Runs any number of timers on one thread using a hierarchical
+ *        timing wheel.
+ *        * schedule, cancel and reschedule are O(1).
+ *        * Timers fire on the service thread, never early, at a resolution
+ *          of one tick (1 ms by default). Callbacks should be short: a slow
+ *          one delays every other timer of the service.
+ *        * The wheel has four levels of 256 slots (2^32 ticks); deadlines
+ *          further out are parked in the top level and re-filed.
+ *        * The thread only wakes for ticks with work to do.
+ *
+ *        Timer and SnoozableTimer are handles over the shared instance().
+ */
+class TimerService {
+public:
+    using Clock = std::chrono::steady_clock;
+    using TimerId = uint64_t;  ///< 0 is never a valid ID
+
+    /**
+     * @brief Constructor, starts the service thread.
+     * @param tick Wheel resolution.
+     */
+    explicit TimerService(std::chrono::milliseconds tick = std::chrono::milliseconds(1));
+
+    /**
+     * @brief Destructor - Stops the thread; pending timers never fire.
+     */
+    ~TimerService();
+
+    TimerService(const TimerService &) = delete;
+    TimerService &operator=(const TimerService &) = delete;
+
+    /**
+     * @brief Process-wide service used by default by Timer and SnoozableTimer.
+     */
+    static TimerService &instance();
+
+    /**
+     * @brief Runs func once at deadline.
+     * @return ID for cancel() and reschedule().
+     */
+    TimerId schedule(Clock::time_point deadline, std::function<void()> func);
+
+    /**
+     * @brief Runs func every interval, first after one interval. The next
+     *        run is timed from the end of the previous one.
+     * @return ID for cancel().
+     */
+    TimerId schedulePeriodic(std::chrono::milliseconds interval, std::function<void()> func);
+
+    /**
+     * @brief Cancels a timer. Once this returns its function is not running
+     *        and will not run again, unless called from that function.
+     * @return false if the timer had already fired or been cancelled.
+     */
+    bool cancel(TimerId id);
+
+    /**
+     * @brief Moves a pending timer to a new deadline. For a periodic timer
+     *        whose function is running, the deadline replaces the next
+     *        interval once the function returns.
+     * @return false if the timer had already fired or been cancelled.
+     */
+    bool reschedule(TimerId id, Clock::time_point deadline);
+
+    /**
+     * @brief Number of pending timers.
+     */
+    size_t size() const;
+
+private:
+    static constexpr size_t kLevels = 4;
+    static constexpr unsigned kSlotBits = 8;
+    static constexpr size_t kSlots = size_t{1} << kSlotBits;
+    static constexpr uint64_t kSlotMask = kSlots - 1;
+    static constexpr uint64_t kNever = UINT64_MAX;
+
+    struct Entry
+    {
+        TimerId id = 0;
+        uint64_t expiry = 0;    // Tick
+        uint64_t interval = 0;  // Ticks; 0 for one-shot timers
+        std::function<void()> func;
+        Entry *prev = nullptr;
+        Entry *next = nullptr;
+        Entry **list = nullptr; // Head of the slot holding this entry
+        bool firing = false;    // Callback running; func is moved out
+        bool rescheduled = false;
+    };
+
+    void run();
+
+    TimerId add(uint64_t expiry, uint64_t interval, std::function<void()> func);
+    uint64_t tickFor(Clock::time_point deadline) const;
+    Clock::time_point timeOf(uint64_t tick) const;
+
+    // All of these require _mutex
+    void insert(Entry &entry);
+    void unlink(Entry &entry);
+    void catchUp(uint64_t nowTick);
+    void advance();
+    void cascade(size_t level);
+    uint64_t nextWheelTick() const;
+    void wakeIfEarlier(uint64_t expiry);
+
+    const Clock::duration _tick;
+    const Clock::time_point _start;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _cv;      // Wakes the service thread
+    std::condition_variable _idleCV;  // Signaled when a callback returns
+    std::unordered_map<TimerId, Entry> _entries;  // Node addresses are stable
+    std::array<std::array<Entry*, kSlots>, kLevels> _wheel{};
+    Entry *_due = nullptr;            // Expired, waiting to run
+    Entry *_dueTail = nullptr;
+    uint64_t _currentTick = 0;
+    uint64_t _sleepUntil = kNever;
+    TimerId _nextId = 1;
+    TimerId _runningId = 0;
+    bool _stop = false;
+
+    std::thread _thread;
+};
+
+}
+
+#endif // COMMONUTILS_TIMERSERVICE_H
@@ -5,7 +5,41 @@
 #include <thread>
 #include <atomic>
 #include <condition_variable>
+#include <ctime>
 #include <mutex>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace
+{
+// Counts how often payloads are copied
+struct CopyCounter
+{
+    static std::atomic<int> copies;
+
+    CopyCounter() = default;
+    explicit CopyCounter(std::string v) : value(std::move(v)) {}
+    CopyCounter(const CopyCounter &other) : value(other.value) { copies.fetch_add(1); }
+    CopyCounter(CopyCounter &&other) noexcept = default;
+    CopyCounter &operator=(const CopyCounter &other) { value = other.value; copies.fetch_add(1); return *this; }
+    CopyCounter &operator=(CopyCounter &&other) noexcept = default;
+
+    std::string value;
+};
+
+std::atomic<int> CopyCounter::copies{0};
+
+bool waitFor(const std::atomic<int> &count, int expected)
+{
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+    while (count.load() < expected && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return count.load() >= expected;
+}
+}
 
 TEST(DataHandlerTest, SignalDataNotifiesListeners) 
 {
@@ -80,6 +114,810 @@ TEST(DataHandlerTest, ExpiredListenersAreRemoved)
 
 }
 
+TEST(DataHandlerTest, RingBufferBackendDeliversInOrder)
+{
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 5000;
+    CommonUtils::DataHandler<int, CommonUtils::RingBuffer<int, 256>> handler;
+
+    std::vector<int> next(kProducers, 0);
+    std::atomic<int> received{0};
+    std::atomic<bool> inOrder{true};
+    handler.registerListener([&](const int& data) {
+        int producer = data / kPerProducer;
+        if (data % kPerProducer != next[producer]++)
+        {
+            inOrder = false;
+        }
+        received.fetch_add(1);
+    });
+
+    // More items than slots: producers must wait for the worker
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p)
+    {
+        producers.emplace_back([&handler, p]() {
+            for (int i = 0; i < kPerProducer; ++i)
+            {
+                handler.signalData(p * kPerProducer + i);
+            }
+        });
+    }
+    for (auto &producer : producers)
+    {
+        producer.join();
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (received.load() < kProducers * kPerProducer && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(received.load(), kProducers * kPerProducer);
+    EXPECT_TRUE(inOrder.load());
+}
+
+TEST(DataHandlerTest, SingleProducerBackendWakesSleepingWorker)
+{
+    CommonUtils::DataHandler<int, CommonUtils::RingBuffer<int, 16, CommonUtils::ProducerMode::Single>> handler;
+    std::atomic<int> sum{0};
+    handler.registerListener([&](const int& data) { sum.fetch_add(data); });
+
+    // Give the worker time to go to sleep between items
+    for (int i = 1; i <= 3; ++i)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        handler.signalData(i);
+    }
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+    while (sum.load() < 6 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    EXPECT_EQ(sum.load(), 6);
+}
+
+TEST(DataHandlerTest, MovedDataIsNeverCopied)
+{
+    CopyCounter::copies = 0;
+    CommonUtils::DataHandler<CopyCounter> handler;
+    std::atomic<int> count{0};
+    std::vector<const CopyCounter*> seen(4, nullptr);
+
+    handler.registerListener([&](const CopyCounter& data) {
+        EXPECT_FALSE(data.value.empty());
+        seen[static_cast<size_t>(count.load())] = &data;
+        count.fetch_add(1);
+    });
+    handler.registerListener([&](const CopyCounter& data) {
+        EXPECT_EQ(seen[static_cast<size_t>(count.load()) - 1], &data);
+        count.fetch_add(1);
+    });
+
+    handler.signalData(CopyCounter("moved"));
+    handler.emplace("emplaced");
+
+    EXPECT_TRUE(waitFor(count, 4));
+    EXPECT_EQ(CopyCounter::copies.load(), 0);
+
+    // Only an lvalue costs a copy
+    CopyCounter lvalue("copied");
+    handler.signalData(lvalue);
+    EXPECT_TRUE(waitFor(count, 6));
+    EXPECT_EQ(CopyCounter::copies.load(), 1);
+}
+
+TEST(DataHandlerTest, RingBufferBackendMovesData)
+{
+    CopyCounter::copies = 0;
+    CommonUtils::DataHandler<CopyCounter, CommonUtils::RingBuffer<CopyCounter, 8>> handler;
+    std::atomic<int> count{0};
+    handler.registerListener([&](const CopyCounter& data) {
+        EXPECT_EQ(data.value, "payload");
+        count.fetch_add(1);
+    });
+
+    handler.signalData(CopyCounter("payload"));
+    handler.emplace("payload");
+
+    EXPECT_TRUE(waitFor(count, 2));
+    EXPECT_EQ(CopyCounter::copies.load(), 0);
+}
+
+TEST(DataHandlerTest, SharedStorageSharesPayload)
+{
+    CopyCounter::copies = 0;
+    CommonUtils::DataHandler<CommonUtils::SharedStorage<CopyCounter>> handler;
+    std::atomic<int> count{0};
+    std::atomic<const CopyCounter*> first{nullptr};
+    std::atomic<bool> same{true};
+
+    auto listener = [&](const CopyCounter& data) {
+        const CopyCounter *expected = nullptr;
+        if (!first.compare_exchange_strong(expected, &data) && expected != &data)
+        {
+            same = false;
+        }
+        count.fetch_add(1);
+    };
+    handler.registerListener(listener);
+    handler.registerListener(listener);
+
+    auto payload = std::make_shared<const CopyCounter>("shared");
+    handler.signalData(payload);
+
+    EXPECT_TRUE(waitFor(count, 2));
+    EXPECT_TRUE(same.load());
+    EXPECT_EQ(first.load(), payload.get());
+    EXPECT_EQ(CopyCounter::copies.load(), 0);
+}
+
+TEST(DataHandlerTest, BatchListenersReceivePendingItemsTogether)
+{
+    constexpr int kItems = 100;
+    CommonUtils::DataHandler<int> handler;
+
+    // Hold the worker on the first item so the rest pile up
+    std::mutex gateMutex;
+    std::condition_variable gateCV;
+    bool released = false;
+    std::atomic<int> itemCount{0};
+    handler.registerListener([&](const int&) {
+        if (itemCount.fetch_add(1) == 0)
+        {
+            std::unique_lock<std::mutex> lk(gateMutex);
+            gateCV.wait_for(lk, std::chrono::milliseconds(500), [&]{ return released; });
+        }
+    });
+
+    std::mutex batchMutex;
+    std::vector<std::vector<int>> batches;
+    std::atomic<int> batchedItems{0};
+    int id = handler.registerBatchListener([&](const std::vector<int>& batch) {
+        std::lock_guard<std::mutex> lk(batchMutex);
+        batches.push_back(batch);
+        batchedItems.fetch_add(static_cast<int>(batch.size()));
+    });
+    EXPECT_EQ(handler.watermarkInfo().first, 2u);
+
+    handler.signalData(0);
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+    while (itemCount.load() == 0 && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    for (int i = 1; i < kItems; ++i)
+    {
+        handler.signalData(i);
+    }
+    {
+        std::lock_guard<std::mutex> lk(gateMutex);
+        released = true;
+    }
+    gateCV.notify_all();
+
+    EXPECT_TRUE(waitFor(batchedItems, kItems));
+    EXPECT_TRUE(waitFor(itemCount, kItems));
+
+    std::lock_guard<std::mutex> lk(batchMutex);
+    ASSERT_EQ(batches.size(), 2u);
+    EXPECT_EQ(batches[0], std::vector<int>{0});
+    ASSERT_EQ(batches[1].size(), static_cast<size_t>(kItems - 1));
+    for (int i = 1; i < kItems; ++i)
+    {
+        EXPECT_EQ(batches[1][static_cast<size_t>(i - 1)], i);
+    }
+
+    handler.unregisterListener(id);
+    EXPECT_EQ(handler.watermarkInfo().first, 1u);
+}
+
+TEST(DataHandlerTest, ListenerCanUnregisterItself)
+{
+    CommonUtils::DataHandler<int> handler;
+    std::atomic<int> selfCalls{0};
+    std::atomic<int> otherCalls{0};
+    int selfId = -1;
+
+    selfId = handler.registerListener([&](const int&) {
+        selfCalls.fetch_add(1);
+        handler.unregisterListener(selfId);
+    });
+    handler.registerListener([&](const int&) { otherCalls.fetch_add(1); });
+
+    for (int i = 0; i < 3; ++i)
+    {
+        handler.signalData(i);
+    }
+
+    EXPECT_TRUE(waitFor(otherCalls, 3));
+    EXPECT_EQ(selfCalls.load(), 1);
+    EXPECT_EQ(handler.watermarkInfo().first, 1u);
+}
+
+TEST(DataHandlerTest, RegistrationDoesNotWaitForCallbacks)
+{
+    CommonUtils::DataHandler<int> handler;
+    std::atomic<bool> inCallback{false};
+    std::atomic<bool> release{false};
+    std::atomic<int> lateCalls{0};
+
+    handler.registerListener([&](const int&) {
+        inCallback = true;
+        while (!release.load())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    handler.signalData(1);
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+    while (!inCallback.load() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_TRUE(inCallback.load());
+
+    // The slow callback is still running: neither of these may block
+    handler.registerListener([&](const int&) { lateCalls.fetch_add(1); });
+    EXPECT_EQ(handler.watermarkInfo().first, 2u);
+
+    release = true;
+    handler.signalData(2);
+    EXPECT_TRUE(waitFor(lateCalls, 1));
+}
+
+TEST(DataHandlerTest, UnregisterWaitsForRunningCallback)
+{
+    CommonUtils::DataHandler<int> handler;
+    std::atomic<bool> inCallback{false};
+    std::atomic<bool> finished{false};
+
+    int id = handler.registerListener([&](const int&) {
+        inCallback = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        finished = true;
+    });
+    handler.signalData(1);
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+    while (!inCallback.load() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    ASSERT_TRUE(inCallback.load());
+
+    handler.unregisterListener(id);
+    EXPECT_TRUE(finished.load());
+}
+
+TEST(DataHandlerTest, UnregisterSleepsWhileCallbackRuns)
+{
+    CommonUtils::DataHandler<int> handler;
+    std::atomic<bool> inCallback{false};
+
+    int id = handler.registerListener([&](const int&) {
+        inCallback = true;
+        std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    });
+    handler.signalData(1);
+    while (!inCallback.load())
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    // CPU time of this thread only: a spinning wait would burn ~200 ms
+    auto cpuNow = []() {
+        timespec ts;
+        clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+        return std::chrono::seconds(ts.tv_sec) + std::chrono::nanoseconds(ts.tv_nsec);
+    };
+    auto before = cpuNow();
+    handler.unregisterListener(id);
+    EXPECT_LT(cpuNow() - before, std::chrono::milliseconds(50));
+}
+
+namespace
+{
+// A slow listener must not hold back a fast one, and each sees its items in order
+void checkSlowListenerOnlyDelaysItself(CommonUtils::DispatchMode mode)
+{
+    constexpr int kItems = 20;
+    CommonUtils::DataHandler<int> handler(mode, 2);
+
+    std::atomic<bool> release{false};
+    std::atomic<int> slowCalls{0};
+    std::atomic<int> fastCalls{0};
+    std::atomic<bool> slowInOrder{true};
+    std::atomic<bool> fastInOrder{true};
+
+    int slowId = handler.registerListener([&](const int& data) {
+        if (data != slowCalls.fetch_add(1)) slowInOrder = false;
+        while (!release.load())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    });
+    int fastId = handler.registerListener([&](const int& data) {
+        if (data != fastCalls.fetch_add(1)) fastInOrder = false;
+    });
+
+    for (int i = 0; i < kItems; ++i)
+    {
+        handler.signalData(i);
+    }
+
+    EXPECT_TRUE(waitFor(fastCalls, kItems));
+    EXPECT_LE(slowCalls.load(), 1);
+
+    // Delivery is counted once the callback returns
+    auto lagOf = [&handler](int id) {
+        for (const auto &listener : handler.listenerLag())
+        {
+            if (listener.id == id) return listener.delivered;
+        }
+        return uint64_t{0};
+    };
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+    while (lagOf(fastId) < static_cast<uint64_t>(kItems) && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+
+    auto lag = handler.listenerLag();
+    ASSERT_EQ(lag.size(), 2u);
+    for (const auto &listener : lag)
+    {
+        if (listener.id == fastId)
+        {
+            EXPECT_EQ(listener.delivered, static_cast<uint64_t>(kItems));
+            EXPECT_EQ(listener.pending, 0u);
+        }
+        else
+        {
+            EXPECT_EQ(listener.id, slowId);
+            EXPECT_EQ(listener.delivered, 0u);
+            EXPECT_EQ(listener.pending, static_cast<uint64_t>(kItems));
+        }
+    }
+
+    release = true;
+    EXPECT_TRUE(waitFor(slowCalls, kItems));
+    EXPECT_TRUE(slowInOrder.load());
+    EXPECT_TRUE(fastInOrder.load());
+}
+
+void checkListenerCanUnregisterItself(CommonUtils::DispatchMode mode)
+{
+    CommonUtils::DataHandler<int> handler(mode, 2);
+    std::atomic<int> selfCalls{0};
+    std::atomic<int> otherCalls{0};
+    std::atomic<int> selfId{-1};
+
+    selfId = handler.registerListener([&](const int&) {
+        selfCalls.fetch_add(1);
+        handler.unregisterListener(selfId.load());
+    });
+    handler.registerListener([&](const int&) { otherCalls.fetch_add(1); });
+
+    for (int i = 0; i < 3; ++i)
+    {
+        handler.signalData(i);
+    }
+
+    EXPECT_TRUE(waitFor(otherCalls, 3));
+    EXPECT_EQ(selfCalls.load(), 1);
+    EXPECT_EQ(handler.watermarkInfo().first, 1u);
+}
+}
+
+TEST(DataHandlerTest, PerListenerModeIsolatesSlowListeners)
+{
+    checkSlowListenerOnlyDelaysItself(CommonUtils::DispatchMode::PerListener);
+}
+
+TEST(DataHandlerTest, PooledModeIsolatesSlowListeners)
+{
+    checkSlowListenerOnlyDelaysItself(CommonUtils::DispatchMode::Pooled);
+}
+
+TEST(DataHandlerTest, PerListenerModeSelfUnregister)
+{
+    checkListenerCanUnregisterItself(CommonUtils::DispatchMode::PerListener);
+}
+
+TEST(DataHandlerTest, PooledModeSelfUnregister)
+{
+    checkListenerCanUnregisterItself(CommonUtils::DispatchMode::Pooled);
+}
+
+TEST(DataHandlerTest, PooledModeBatchListener)
+{
+    CommonUtils::DataHandler<int> handler(CommonUtils::DispatchMode::Pooled, 2);
+    std::atomic<int> total{0};
+    handler.registerBatchListener([&](const std::vector<int>& batch) {
+        total.fetch_add(static_cast<int>(batch.size()));
+    });
+
+    for (int i = 0; i < 50; ++i)
+    {
+        handler.signalData(i);
+    }
+    EXPECT_TRUE(waitFor(total, 50));
+}
+
+namespace
+{
+// Holds the worker inside the first callback so items pile up in the queue
+struct WorkerGate
+{
+    std::atomic<bool> entered{false};
+    std::atomic<bool> released{false};
+
+    void hold()
+    {
+        if (entered.exchange(true)) return;
+        while (!released.load())
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+
+    bool waitEntered()
+    {
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+        while (!entered.load() && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+        return entered.load();
+    }
+};
+
+// Signals 0..9 with the worker held on item 0; returns what the listener saw
+std::vector<int> runOverflow(CommonUtils::OverflowPolicy policy, CommonUtils::DataHandler<int>::Metrics &metrics)
+{
+    CommonUtils::DataHandler<int> handler;
+    handler.setCapacity(3, policy);
+
+    WorkerGate gate;
+    std::mutex seenMutex;
+    std::vector<int> seen;
+    std::atomic<int> count{0};
+    handler.registerListener([&](const int& data) {
+        {
+            std::lock_guard<std::mutex> lk(seenMutex);
+            seen.push_back(data);
+        }
+        count.fetch_add(1);
+        gate.hold();
+    });
+
+    handler.signalData(0);
+    EXPECT_TRUE(gate.waitEntered());
+    for (int i = 1; i < 10; ++i)
+    {
+        handler.signalData(i);
+    }
+    metrics = handler.metrics();
+    gate.released = true;
+
+    EXPECT_TRUE(waitFor(count, 4));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::lock_guard<std::mutex> lk(seenMutex);
+    return seen;
+}
+}
+
+TEST(DataHandlerTest, DropNewestKeepsOldestItems)
+{
+    CommonUtils::DataHandler<int>::Metrics metrics;
+    auto seen = runOverflow(CommonUtils::OverflowPolicy::DropNewest, metrics);
+    EXPECT_EQ(seen, (std::vector<int>{0, 1, 2, 3}));
+    EXPECT_EQ(metrics.queued, 3u);
+    EXPECT_EQ(metrics.dropped, 6u);
+    EXPECT_EQ(metrics.conflated, 0u);
+}
+
+TEST(DataHandlerTest, DropOldestKeepsNewestItems)
+{
+    CommonUtils::DataHandler<int>::Metrics metrics;
+    auto seen = runOverflow(CommonUtils::OverflowPolicy::DropOldest, metrics);
+    EXPECT_EQ(seen, (std::vector<int>{0, 7, 8, 9}));
+    EXPECT_EQ(metrics.queued, 3u);
+    EXPECT_EQ(metrics.dropped, 6u);
+}
+
+TEST(DataHandlerTest, BlockWaitsForSpace)
+{
+    CommonUtils::DataHandler<int> handler;
+    handler.setCapacity(3, CommonUtils::OverflowPolicy::Block);
+
+    WorkerGate gate;
+    std::atomic<int> count{0};
+    std::atomic<int> sum{0};
+    handler.registerListener([&](const int& data) {
+        sum.fetch_add(data);
+        count.fetch_add(1);
+        gate.hold();
+    });
+
+    handler.signalData(0);
+    ASSERT_TRUE(gate.waitEntered());
+
+    std::atomic<bool> producerDone{false};
+    std::thread producer([&]() {
+        for (int i = 1; i < 10; ++i)
+        {
+            handler.signalData(i);
+        }
+        producerDone = true;
+    });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_FALSE(producerDone.load());
+    EXPECT_EQ(handler.watermarkInfo().second, 3u);
+
+    gate.released = true;
+    producer.join();
+    EXPECT_TRUE(waitFor(count, 10));
+    EXPECT_EQ(sum.load(), 45);
+    EXPECT_EQ(handler.metrics().dropped, 0u);
+}
+
+TEST(DataHandlerTest, ListenerBacklogDropsOldest)
+{
+    CommonUtils::DataHandler<int> handler(CommonUtils::DispatchMode::PerListener);
+    handler.setCapacity(3, CommonUtils::OverflowPolicy::DropOldest);
+
+    WorkerGate gate;
+    std::mutex seenMutex;
+    std::vector<int> seen;
+    std::atomic<int> count{0};
+    handler.registerListener([&](const int& data) {
+        {
+            std::lock_guard<std::mutex> lk(seenMutex);
+            seen.push_back(data);
+        }
+        count.fetch_add(1);
+        gate.hold();
+    });
+
+    handler.signalData(0);
+    ASSERT_TRUE(gate.waitEntered());
+    for (int i = 1; i < 10; ++i)
+    {
+        // One item per drained batch
+        handler.signalData(i);
+        auto deadline = std::chrono::steady_clock::now() + std::chrono::milliseconds(500);
+        while (handler.metrics().dequeued < static_cast<uint64_t>(i + 1) && std::chrono::steady_clock::now() < deadline)
+        {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+        }
+    }
+    gate.released = true;
+
+    EXPECT_TRUE(waitFor(count, 4));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    {
+        std::lock_guard<std::mutex> lk(seenMutex);
+        EXPECT_EQ(seen, (std::vector<int>{0, 7, 8, 9}));
+    }
+    auto metrics = handler.metrics();
+    ASSERT_EQ(metrics.listeners.size(), 1u);
+    EXPECT_EQ(metrics.listeners[0].dropped, 6u);
+    EXPECT_EQ(handler.listenerLag()[0].pending, 0u);
+}
+
+TEST(DataHandlerTest, ListenerBacklogBlocksWorker)
+{
+    CommonUtils::DataHandler<int> handler(CommonUtils::DispatchMode::PerListener);
+    handler.setCapacity(2, CommonUtils::OverflowPolicy::Block);
+
+    WorkerGate gate;
+    std::atomic<int> count{0};
+    std::atomic<int> sum{0};
+    handler.registerListener([&](const int& data) {
+        sum.fetch_add(data);
+        count.fetch_add(1);
+        gate.hold();
+    });
+
+    handler.signalData(0);
+    ASSERT_TRUE(gate.waitEntered());
+    for (int i = 1; i <= 4; ++i)
+    {
+        handler.signalData(i);
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+
+    // 1 and 2 fill the backlog; the worker holds 3 and 4 stays queued
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    auto metrics = handler.metrics();
+    EXPECT_EQ(metrics.dequeued, 4u);
+    EXPECT_EQ(metrics.queued, 1u);
+
+    gate.released = true;
+    EXPECT_TRUE(waitFor(count, 5));
+    EXPECT_EQ(sum.load(), 10);
+    EXPECT_EQ(handler.metrics().listeners[0].dropped, 0u);
+}
+
+TEST(DataHandlerTest, ConflateKeepsLatestPerKey)
+{
+    CommonUtils::DataHandler<std::string> handler;
+    EXPECT_TRUE(handler.setCapacity(0, CommonUtils::OverflowPolicy::Conflate,
+                                    [](const std::string& data) { return data.substr(0, data.find(':')); }));
+
+    WorkerGate gate;
+    std::mutex seenMutex;
+    std::vector<std::string> seen;
+    std::atomic<int> count{0};
+    handler.registerListener([&](const std::string& data) {
+        {
+            std::lock_guard<std::mutex> lk(seenMutex);
+            seen.push_back(data);
+        }
+        count.fetch_add(1);
+        gate.hold();
+    });
+
+    handler.signalData("start:0");
+    ASSERT_TRUE(gate.waitEntered());
+    handler.signalData("a:1");
+    handler.signalData("b:1");
+    handler.signalData("a:2");
+    handler.signalData("a:3");
+
+    auto [listeners, queued] = handler.watermarkInfo();
+    EXPECT_EQ(listeners, 1u);
+    EXPECT_EQ(queued, 2u);
+    EXPECT_EQ(handler.metrics().conflated, 2u);
+
+    gate.released = true;
+    EXPECT_TRUE(waitFor(count, 3));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::lock_guard<std::mutex> lk(seenMutex);
+    EXPECT_EQ(seen, (std::vector<std::string>{"start:0", "a:3", "b:1"}));
+}
+
+TEST(DataHandlerTest, ConflateWithoutKeyIsRejected)
+{
+    CommonUtils::DataHandler<int> handler;
+    EXPECT_FALSE(handler.setCapacity(2, CommonUtils::OverflowPolicy::Conflate));
+
+    // Still unbounded
+    for (int i = 0; i < 5; ++i)
+    {
+        handler.signalData(i);
+    }
+    EXPECT_EQ(handler.metrics().dropped, 0u);
+}
+
+TEST(DataHandlerTest, MetricsCountProducersAndListeners)
+{
+    constexpr int kProducers = 3;
+    constexpr int kPerProducer = 1000;
+    CommonUtils::DataHandler<int> handler;
+    handler.enableMetrics();
+
+    std::atomic<int> count{0};
+    int okId = handler.registerListener([&](const int&) { count.fetch_add(1); });
+    int throwingId = handler.registerListener([](const int& data) {
+        if (data % 10 == 0) throw std::runtime_error("bad item");
+    });
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p)
+    {
+        producers.emplace_back([&handler]() {
+            for (int i = 0; i < kPerProducer; ++i)
+            {
+                handler.signalData(i);
+            }
+        });
+    }
+    for (auto &producer : producers)
+    {
+        producer.join();
+    }
+    EXPECT_TRUE(waitFor(count, kProducers * kPerProducer));
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+
+    auto metrics = handler.metrics();
+    EXPECT_EQ(metrics.enqueued, static_cast<uint64_t>(kProducers * kPerProducer));
+    EXPECT_EQ(metrics.dequeued, static_cast<uint64_t>(kProducers * kPerProducer));
+    EXPECT_EQ(metrics.queued, 0u);
+    EXPECT_GE(metrics.highWaterMark, 1u);
+    EXPECT_GE(metrics.dispatchLatency.count, 1u);
+
+    ASSERT_EQ(metrics.listeners.size(), 2u);
+    for (const auto &listener : metrics.listeners)
+    {
+        EXPECT_EQ(listener.delivered, static_cast<uint64_t>(kProducers * kPerProducer));
+        EXPECT_EQ(listener.callbackTime.count, static_cast<uint64_t>(kProducers * kPerProducer));
+        if (listener.id == throwingId)
+        {
+            EXPECT_EQ(listener.exceptions, static_cast<uint64_t>(kProducers * kPerProducer / 10));
+        }
+        else
+        {
+            EXPECT_EQ(listener.id, okId);
+            EXPECT_EQ(listener.exceptions, 0u);
+        }
+    }
+}
+
+TEST(DataHandlerTest, MetricsRetireExitedProducers)
+{
+    constexpr int kThreads = 200;
+    CommonUtils::DataHandler<int> handler;
+    std::atomic<int> count{0};
+    handler.registerListener([&](const int&) { count.fetch_add(1); });
+
+    for (int t = 0; t < kThreads; ++t)
+    {
+        std::thread([&handler]() {
+            handler.signalData(1);
+            handler.signalData(2);
+        }).join();
+    }
+    EXPECT_TRUE(waitFor(count, 2 * kThreads));
+
+    auto metrics = handler.metrics();
+    EXPECT_EQ(metrics.enqueued, static_cast<uint64_t>(2 * kThreads));
+    EXPECT_EQ(metrics.producerThreads, 0u);
+
+    // A thread that outlives the handlers it signaled
+    std::thread([]() {
+        for (int i = 0; i < 10; ++i)
+        {
+            CommonUtils::DataHandler<int> shortLived;
+            shortLived.signalData(i);
+        }
+        CommonUtils::DataHandler<int> last;
+        last.signalData(0);
+        EXPECT_EQ(last.metrics().producerThreads, 1u);
+    }).join();
+}
+
+TEST(DataHandlerTest, MetricsHighWaterMarkFollowsBacklog)
+{
+    CommonUtils::DataHandler<int> handler(CommonUtils::DispatchMode::PerListener);
+    WorkerGate gate;
+    std::atomic<int> count{0};
+    handler.registerListener([&](const int&) {
+        count.fetch_add(1);
+        gate.hold();
+    });
+
+    handler.signalData(0);
+    ASSERT_TRUE(gate.waitEntered());
+    auto before = handler.metrics();
+    EXPECT_EQ(before.listeners.size(), 1u);
+    EXPECT_EQ(before.listeners[0].callbackTime.count, 0u);  // Timing is off by default
+    gate.released = true;
+
+    // Fill the queue while the worker is held in a slow batch listener
+    CommonUtils::DataHandler<int> serial;
+    WorkerGate serialGate;
+    std::atomic<int> drained{0};
+    serial.registerBatchListener([&](const std::vector<int>& batch) {
+        drained.fetch_add(static_cast<int>(batch.size()));
+        serialGate.hold();
+    });
+    serial.signalData(0);
+    ASSERT_TRUE(serialGate.waitEntered());
+    for (int i = 1; i <= 50; ++i)
+    {
+        serial.signalData(i);
+    }
+    serialGate.released = true;
+    EXPECT_TRUE(waitFor(drained, 51));
+    EXPECT_EQ(serial.metrics().highWaterMark, 50u);
+}
+
 int main(int argc, char **argv) 
 {
     ::testing::InitGoogleTest(&argc, argv);
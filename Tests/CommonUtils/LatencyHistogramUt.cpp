@@ -0,0 +1,49 @@
+#include "CommonUtils/LatencyHistogram.h"
+#include <gtest/gtest.h>
+
+TEST(LatencyHistogramTest, RecordsIntoLog2Buckets)
+{
+    CommonUtils::LatencyHistogram histogram;
+    histogram.record(0);
+    histogram.record(1);
+    histogram.record(3);
+    histogram.record(1000);
+
+    auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.count, 4u);
+    EXPECT_EQ(snapshot.totalNs, 1004u);
+    EXPECT_EQ(snapshot.maxNs, 1000u);
+    EXPECT_EQ(snapshot.buckets[0], 2u);  // 0 and 1
+    EXPECT_EQ(snapshot.buckets[1], 1u);  // 3
+    EXPECT_EQ(snapshot.buckets[9], 1u);  // 1000 is in [512, 1024)
+}
+
+TEST(LatencyHistogramTest, PercentilesUseBucketBounds)
+{
+    CommonUtils::LatencyHistogram histogram;
+    EXPECT_EQ(histogram.snapshot().percentileNs(50), 0u);
+
+    for (int i = 0; i < 99; ++i)
+    {
+        histogram.record(100);
+    }
+    histogram.record(1000000);
+
+    auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.percentileNs(50), 127u);
+    EXPECT_EQ(snapshot.percentileNs(100), 1048575u);
+}
+
+TEST(LatencyHistogramTest, HugeValuesLandInLastBucket)
+{
+    CommonUtils::LatencyHistogram histogram;
+    histogram.record(UINT64_MAX);
+    auto snapshot = histogram.snapshot();
+    EXPECT_EQ(snapshot.buckets[CommonUtils::LatencyHistogram::kBuckets - 1], 1u);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,132 @@
+#include "CommonUtils/RingBuffer.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(RingBufferTest, PushPopKeepsOrder)
+{
+    CommonUtils::RingBuffer<int, 8> ring;
+    EXPECT_TRUE(ring.empty());
+
+    for (int i = 0; i < 5; ++i)
+    {
+        EXPECT_TRUE(ring.push(i));
+    }
+    EXPECT_EQ(ring.size(), 5u);
+
+    int value = -1;
+    for (int i = 0; i < 5; ++i)
+    {
+        ASSERT_TRUE(ring.pop(value));
+        EXPECT_EQ(value, i);
+    }
+    EXPECT_FALSE(ring.pop(value));
+    EXPECT_TRUE(ring.empty());
+}
+
+TEST(RingBufferTest, PushFailsWhenFull)
+{
+    CommonUtils::RingBuffer<int, 4, CommonUtils::ProducerMode::Single> ring;
+    for (int i = 0; i < 4; ++i)
+    {
+        EXPECT_TRUE(ring.push(i));
+    }
+    EXPECT_FALSE(ring.push(4));
+
+    // Wraps around once a slot is freed
+    int value = -1;
+    ASSERT_TRUE(ring.pop(value));
+    EXPECT_EQ(value, 0);
+    EXPECT_TRUE(ring.push(4));
+    EXPECT_EQ(ring.size(), 4u);
+}
+
+TEST(RingBufferTest, PopAllDrainsInOrder)
+{
+    CommonUtils::RingBuffer<int, 8> ring;
+    std::vector<int> batch;
+    EXPECT_FALSE(ring.popAll(batch));
+
+    for (int i = 0; i < 6; ++i)
+    {
+        ring.push(i);
+    }
+    ASSERT_TRUE(ring.popAll(batch));
+    EXPECT_EQ(batch, (std::vector<int>{0, 1, 2, 3, 4, 5}));
+    EXPECT_TRUE(ring.empty());
+
+    // Slots are reusable after a drain
+    for (int i = 0; i < 8; ++i)
+    {
+        EXPECT_TRUE(ring.push(i));
+    }
+    batch.clear();
+    ASSERT_TRUE(ring.popAll(batch));
+    EXPECT_EQ(batch.size(), 8u);
+}
+
+TEST(RingBufferTest, ReleasesRemainingItems)
+{
+    auto item = std::make_shared<std::string>("payload");
+    {
+        CommonUtils::RingBuffer<std::shared_ptr<std::string>, 4> ring;
+        ring.push(item);
+        ring.push(item);
+        EXPECT_EQ(item.use_count(), 3);
+    }
+    EXPECT_EQ(item.use_count(), 1);
+}
+
+TEST(RingBufferTest, MultipleProducersDeliverEverything)
+{
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 20000;
+    CommonUtils::RingBuffer<int, 1024> ring;
+
+    std::vector<std::thread> producers;
+    for (int p = 0; p < kProducers; ++p)
+    {
+        producers.emplace_back([&ring, p]()
+        {
+            for (int i = 0; i < kPerProducer; ++i)
+            {
+                while (!ring.push(p * kPerProducer + i))
+                {
+                    std::this_thread::yield();
+                }
+            }
+        });
+    }
+
+    // Items from one producer must come out in the order it pushed them
+    std::vector<int> next(kProducers, 0);
+    int received = 0;
+    int value;
+    while (received < kProducers * kPerProducer)
+    {
+        if (!ring.pop(value))
+        {
+            std::this_thread::yield();
+            continue;
+        }
+        int producer = value / kPerProducer;
+        ASSERT_EQ(value % kPerProducer, next[producer]);
+        ++next[producer];
+        ++received;
+    }
+
+    for (auto &producer : producers)
+    {
+        producer.join();
+    }
+    EXPECT_TRUE(ring.empty());
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -1,6 +1,8 @@
 #include <gtest/gtest.h>
+#include <atomic>
 #include <chrono>
 #include <thread>
+#include <vector>
 #include "CommonUtils/SnoozableTimer.h"
 
 class SnoozableTimerTest : public ::testing::Test {
@@ -191,6 +193,38 @@ TEST_F(SnoozableTimerTest, SnoozeTimeoutSnoozeAgain) {
     EXPECT_EQ(snExecutionCount, 2);
 }
 
+// Snoozes from several threads hold the timer off until they all stop
+TEST_F(SnoozableTimerTest, ConcurrentSnoozes) {
+    std::atomic<int> lnFired{0};
+    SnoozableTimer executor([&lnFired]() { ++lnFired; }, 50);
+    executor.start();
+
+    std::atomic<bool> lbSnoozing{true};
+    std::vector<std::thread> lcThreads;
+    for (int i = 0; i < 4; ++i)
+    {
+        lcThreads.emplace_back([&]()
+        {
+            while (lbSnoozing)
+            {
+                executor.snooze();
+            }
+        });
+    }
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    lbSnoozing = false;
+    for (auto &lcThread : lcThreads)
+    {
+        lcThread.join();
+    }
+    EXPECT_EQ(lnFired.load(), 0);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(lnFired.load(), 1);
+    executor.stop();
+}
+
 int main(int argc, char **argv) {
     ::testing::InitGoogleTest(&argc, argv);
     return RUN_ALL_TESTS();
@@ -0,0 +1,213 @@
+#include "CommonUtils/TimerService.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <mutex>
+#include <random>
+#include <thread>
+#include <vector>
+
+using CommonUtils::TimerService;
+using Clock = TimerService::Clock;
+
+namespace
+{
+bool waitFor(const std::atomic<int> &counter, int expected, std::chrono::milliseconds timeout = std::chrono::milliseconds(2000))
+{
+    auto deadline = Clock::now() + timeout;
+    while (counter.load() < expected && Clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return counter.load() >= expected;
+}
+}
+
+TEST(TimerServiceTest, OneShotNeverFiresEarly)
+{
+    TimerService service;
+    std::atomic<int> fired{0};
+    auto deadline = Clock::now() + std::chrono::milliseconds(50);
+    Clock::time_point firedAt;
+
+    service.schedule(deadline, [&]()
+    {
+        firedAt = Clock::now();
+        ++fired;
+    });
+
+    ASSERT_TRUE(waitFor(fired, 1));
+    EXPECT_GE(firedAt, deadline);
+    EXPECT_LT(firedAt, deadline + std::chrono::milliseconds(40));
+    EXPECT_EQ(service.size(), 0u);
+}
+
+TEST(TimerServiceTest, PastDeadlineFiresImmediately)
+{
+    TimerService service;
+    std::atomic<int> fired{0};
+    service.schedule(Clock::now() - std::chrono::seconds(1), [&]() { ++fired; });
+    EXPECT_TRUE(waitFor(fired, 1, std::chrono::milliseconds(20)));
+}
+
+TEST(TimerServiceTest, FiresInDeadlineOrder)
+{
+    TimerService service;
+    std::mutex mutex;
+    std::vector<int> order;
+    std::atomic<int> fired{0};
+    auto now = Clock::now();
+
+    // 300 ms is past the first wheel level and has to cascade
+    for (int ms : {300, 20, 120, 5, 60})
+    {
+        service.schedule(now + std::chrono::milliseconds(ms), [&, ms]()
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            order.push_back(ms);
+            ++fired;
+        });
+    }
+
+    ASSERT_TRUE(waitFor(fired, 5));
+    EXPECT_EQ(order, (std::vector<int>{5, 20, 60, 120, 300}));
+}
+
+TEST(TimerServiceTest, CancelPreventsFiring)
+{
+    TimerService service;
+    std::atomic<int> fired{0};
+    auto id = service.schedule(Clock::now() + std::chrono::milliseconds(30), [&]() { ++fired; });
+
+    EXPECT_EQ(service.size(), 1u);
+    EXPECT_TRUE(service.cancel(id));
+    EXPECT_FALSE(service.cancel(id));
+    EXPECT_EQ(service.size(), 0u);
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(60));
+    EXPECT_EQ(fired.load(), 0);
+}
+
+TEST(TimerServiceTest, RescheduleMovesDeadline)
+{
+    TimerService service;
+    std::atomic<int> fired{0};
+    auto id = service.schedule(Clock::now() + std::chrono::milliseconds(50), [&]() { ++fired; });
+
+    EXPECT_TRUE(service.reschedule(id, Clock::now() + std::chrono::milliseconds(150)));
+    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    EXPECT_EQ(fired.load(), 0);
+
+    ASSERT_TRUE(waitFor(fired, 1));
+    EXPECT_FALSE(service.reschedule(id, Clock::now()));
+}
+
+TEST(TimerServiceTest, RescheduleEarlierWakesService)
+{
+    TimerService service;
+    std::atomic<int> fired{0};
+    auto id = service.schedule(Clock::now() + std::chrono::seconds(10), [&]() { ++fired; });
+
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    EXPECT_TRUE(service.reschedule(id, Clock::now() + std::chrono::milliseconds(10)));
+    EXPECT_TRUE(waitFor(fired, 1, std::chrono::milliseconds(100)));
+}
+
+TEST(TimerServiceTest, PeriodicRepeatsUntilCancelled)
+{
+    TimerService service;
+    std::atomic<int> fired{0};
+    auto id = service.schedulePeriodic(std::chrono::milliseconds(10), [&]() { ++fired; });
+
+    ASSERT_TRUE(waitFor(fired, 5));
+    EXPECT_TRUE(service.cancel(id));
+    int count = fired.load();
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    EXPECT_EQ(fired.load(), count);
+}
+
+TEST(TimerServiceTest, CancelWaitsForRunningCallback)
+{
+    TimerService service;
+    std::atomic<int> started{0};
+    std::atomic<bool> finished{false};
+    auto id = service.schedule(Clock::now(), [&]()
+    {
+        ++started;
+        std::this_thread::sleep_for(std::chrono::milliseconds(50));
+        finished = true;
+    });
+
+    ASSERT_TRUE(waitFor(started, 1));
+    EXPECT_FALSE(service.cancel(id));
+    EXPECT_TRUE(finished.load());
+}
+
+TEST(TimerServiceTest, CallbackMayCancelItself)
+{
+    TimerService service;
+    std::atomic<int> fired{0};
+    std::atomic<TimerService::TimerId> id{0};
+    id = service.schedulePeriodic(std::chrono::milliseconds(5), [&]()
+    {
+        ++fired;
+        service.cancel(id.load());
+    });
+
+    ASSERT_TRUE(waitFor(fired, 1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(30));
+    EXPECT_EQ(fired.load(), 1);
+    EXPECT_EQ(service.size(), 0u);
+}
+
+TEST(TimerServiceTest, PeriodicMayRescheduleItself)
+{
+    TimerService service;
+    std::atomic<int> fired{0};
+    std::atomic<TimerService::TimerId> id{0};
+    id = service.schedulePeriodic(std::chrono::milliseconds(5), [&]()
+    {
+        // Second run pushed out; the function must survive the move
+        if (++fired == 1)
+        {
+            EXPECT_TRUE(service.reschedule(id.load(), Clock::now() + std::chrono::milliseconds(40)));
+        }
+    });
+
+    ASSERT_TRUE(waitFor(fired, 1));
+    std::this_thread::sleep_for(std::chrono::milliseconds(25));
+    EXPECT_EQ(fired.load(), 1);
+
+    ASSERT_TRUE(waitFor(fired, 3));
+    EXPECT_TRUE(service.cancel(id.load()));
+}
+
+TEST(TimerServiceTest, ManyTimersAllFireOnTime)
+{
+    constexpr int kTimers = 20000;
+    TimerService service;
+    std::atomic<int> fired{0};
+    std::atomic<int> early{0};
+
+    std::mt19937 random(42);
+    std::uniform_int_distribution<int> delay(0, 600);
+    auto now = Clock::now();
+    for (int i = 0; i < kTimers; ++i)
+    {
+        auto deadline = now + std::chrono::milliseconds(delay(random));
+        service.schedule(deadline, [&, deadline]()
+        {
+            if (Clock::now() < deadline) ++early;
+            ++fired;
+        });
+    }
+
+    ASSERT_TRUE(waitFor(fired, kTimers, std::chrono::seconds(5)));
+    EXPECT_EQ(early.load(), 0);
+    EXPECT_EQ(service.size(), 0u);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,108 @@
+#include "InProcessBus.h"
+#include "InProcessPublisher.h"
+#include "InProcessSubscriber.h"
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+
+#include <MessageOne.pb.h>
+#include <MessageTwo.pb.h>
+
+// Typed subscribers receive the publisher's very object
+TEST(InProcessTransportTest, TypedSubscriberSharesPublishedObject)
+{
+    InProcessBus bus;
+    InProcessPublisher pub("Test", bus);
+    InProcessSubscriber sub("Test", bus);
+
+    std::shared_ptr<const MessageOne> received;
+    sub.subscribe<MessageOne>("MessageOne", [&](const std::string &topic, std::shared_ptr<const MessageOne> msg)
+    {
+        EXPECT_EQ(topic, "Test/MessageOne");
+        received = std::move(msg);
+    });
+
+    auto msg = std::make_shared<MessageOne>();
+    msg->set_mcmessagestring("hello");
+    msg->set_mntime(42);
+    EXPECT_TRUE(pub.publish("MessageOne", msg));
+
+    // Delivery is synchronous, no waiting required
+    ASSERT_TRUE(received);
+    EXPECT_EQ(received.get(), msg.get());
+}
+
+// Bytes subscribers get a serialization identical to the other transports
+TEST(InProcessTransportTest, BytesSubscriberReceivesSerializedMessage)
+{
+    InProcessBus bus;
+    InProcessPublisher pub("Test", bus);
+    InProcessSubscriber sub("Test", bus);
+
+    int count = 0;
+    std::string data;
+    sub.subscribe("MessageOne", [&](const std::string &, const std::string &bytes)
+    {
+        ++count;
+        data = bytes;
+    });
+
+    MessageOne msg;
+    msg.set_mcmessagestring("by reference");
+    msg.set_mntime(7);
+    EXPECT_TRUE(pub.publish("MessageOne", msg));
+
+    EXPECT_EQ(count, 1);
+    MessageOne parsed;
+    ASSERT_TRUE(parsed.ParseFromString(data));
+    EXPECT_EQ(parsed.mcmessagestring(), "by reference");
+    EXPECT_EQ(parsed.mntime(), 7);
+}
+
+// A typed subscriber of a different type is fed through the bytes path
+TEST(InProcessTransportTest, MismatchedTypeIsConverted)
+{
+    InProcessBus bus;
+    InProcessPublisher pub("Test", bus);
+    InProcessSubscriber sub("Test", bus);
+
+    std::string text;
+    sub.subscribe<MessageTwo>("Shared", [&](const std::string &, std::shared_ptr<const MessageTwo> msg)
+    {
+        text = msg->mcmessagestring();
+    });
+
+    auto msg = std::make_shared<MessageOne>();
+    msg->set_mcmessagestring("same layout");
+    pub.publish("Shared", msg);
+
+    EXPECT_EQ(text, "same layout");
+}
+
+// Namespaces isolate topics and destroyed subscribers stop receiving
+TEST(InProcessTransportTest, NamespacesAndUnsubscribe)
+{
+    InProcessBus bus;
+    InProcessPublisher pub("A", bus);
+
+    int count = 0;
+    {
+        InProcessSubscriber subA("A", bus);
+        InProcessSubscriber subB("B", bus);
+        subA.subscribe("Topic", [&](const std::string &, const std::string &) { ++count; });
+        subB.subscribe("Topic", [&](const std::string &, const std::string &) { count += 100; });
+
+        EXPECT_TRUE(pub.publish("Topic", MessageOne()));
+        EXPECT_EQ(count, 1);
+    }
+
+    EXPECT_FALSE(bus.hasSubscribers("A/Topic"));
+    EXPECT_FALSE(pub.publish("Topic", MessageOne()));
+    EXPECT_EQ(count, 1);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,98 @@
+#include "LastValueCache.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Snapshot protocol messages, built and parsed without a network
+
+namespace
+{
+std::string frameString(zframe_t *frame)
+{
+    return std::string(reinterpret_cast<const char*>(zframe_data(frame)), zframe_size(frame));
+}
+
+std::vector<std::string> frames(zmsg_t *msg)
+{
+    std::vector<std::string> result;
+    for (zframe_t *frame = zmsg_first(msg); frame; frame = zmsg_next(msg))
+    {
+        result.push_back(frameString(frame));
+    }
+    return result;
+}
+
+void store(LastValueCache &cache, const std::string &topic, const std::string &value)
+{
+    cache.store(topic, value.data(), value.size());
+}
+}
+
+TEST(LastValueCacheTest, RequestNamesEveryTopic)
+{
+    zmsg_t *request = LastValueCache::buildRequest({"ns/a", "ns/b"});
+
+    EXPECT_TRUE(LastValueCache::isCommand(request, LastValueCache::kRequestCommand));
+    EXPECT_FALSE(LastValueCache::isCommand(request, LastValueCache::kReplyCommand));
+    EXPECT_EQ(frames(request), (std::vector<std::string>{LastValueCache::kRequestCommand, "ns/a", "ns/b"}));
+    zmsg_destroy(&request);
+}
+
+TEST(LastValueCacheTest, ReplyCarriesCachedTopicsOnly)
+{
+    LastValueCache cache(1024);
+    store(cache, "ns/a", "first");
+    store(cache, "ns/a", "latest");
+    store(cache, "ns/c", std::string("bin\0ary", 7));
+    EXPECT_EQ(cache.size(), 2u);
+
+    zmsg_t *request = LastValueCache::buildRequest({"ns/a", "ns/b", "ns/c"});
+    zmsg_t *reply = cache.buildReply(request);
+    ASSERT_NE(reply, nullptr);
+
+    EXPECT_TRUE(LastValueCache::isCommand(reply, LastValueCache::kReplyCommand));
+    EXPECT_EQ(frames(reply), (std::vector<std::string>{
+        LastValueCache::kReplyCommand, "ns/a", "latest", "ns/c", std::string("bin\0ary", 7)}));
+
+    zmsg_destroy(&reply);
+    zmsg_destroy(&request);
+}
+
+TEST(LastValueCacheTest, NoReplyWithoutCachedValues)
+{
+    LastValueCache cache(1024);
+    store(cache, "ns/a", "value");
+
+    zmsg_t *request = LastValueCache::buildRequest({"ns/b"});
+    EXPECT_EQ(cache.buildReply(request), nullptr);
+    zmsg_destroy(&request);
+
+    // Only requests are answered
+    zmsg_t *other = zmsg_new();
+    zmsg_addstr(other, LastValueCache::kReplyCommand);
+    zmsg_addstr(other, "ns/a");
+    EXPECT_EQ(cache.buildReply(other), nullptr);
+    zmsg_destroy(&other);
+
+    EXPECT_EQ(cache.buildReply(nullptr), nullptr);
+    EXPECT_FALSE(LastValueCache::isCommand(nullptr, LastValueCache::kRequestCommand));
+}
+
+TEST(LastValueCacheTest, OversizedValueEvictsTopic)
+{
+    LastValueCache cache(8);
+    store(cache, "ns/a", "small");
+    store(cache, "ns/a", "far too large");
+    EXPECT_EQ(cache.size(), 0u);
+
+    zmsg_t *request = LastValueCache::buildRequest({"ns/a"});
+    EXPECT_EQ(cache.buildReply(request), nullptr);
+    zmsg_destroy(&request);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,197 @@
+#include "MessageRecorder.h"
+#include "MessageReplayer.h"
+#include <gtest/gtest.h>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+// MessageRecorder writes a recording to disk, MessageReplayer reads it back.
+
+namespace
+{
+struct Replayed
+{
+    std::string topic;
+    std::string payload;
+    int64_t timestampNs;
+};
+
+std::string basePath(const char *test)
+{
+    return ::testing::TempDir() + "zyre.recording." + std::to_string(getpid()) + "." + test;
+}
+
+void removeRecording(const std::string &base)
+{
+    std::remove(MessageRecorder::indexPath(base).c_str());
+    for (uint32_t segment = 0; segment < 64; ++segment)
+    {
+        std::remove(MessageRecorder::segmentPath(base, segment).c_str());
+    }
+}
+
+MessageReplayer::ReplayHandler collectInto(std::vector<Replayed> &replayed)
+{
+    return [&replayed](std::string_view topic, std::string_view payload, int64_t timestampNs)
+    {
+        replayed.push_back({std::string(topic), std::string(payload), timestampNs});
+    };
+}
+
+// 100 records of ~100 bytes over 4 KiB segments, 10 ns apart
+void recordSample(const std::string &base)
+{
+    MessageRecorder recorder(base, 4096, 4);
+    ASSERT_TRUE(recorder.open());
+    for (int i = 0; i < 100; ++i)
+    {
+        std::string payload(64, static_cast<char>('a' + i % 26));
+        payload += std::to_string(i);
+        ASSERT_TRUE(recorder.record("ns/topic" + std::to_string(i % 3), payload.data(), payload.size(), 1000 + i * 10));
+    }
+    EXPECT_EQ(recorder.recordCount(), 100u);
+}
+}
+
+TEST(MessageRecordingTest, ReplaysEveryRecordAcrossSegments)
+{
+    std::string base = basePath("all");
+    recordSample(base);
+
+    MessageReplayer replayer(base);
+    ASSERT_TRUE(replayer.open());
+    EXPECT_EQ(replayer.firstTimestamp(), 1000);
+
+    std::vector<Replayed> replayed;
+    EXPECT_EQ(replayer.replay(collectInto(replayed), MessageReplayer::kAsFastAsPossible), 100u);
+    ASSERT_EQ(replayed.size(), 100u);
+    for (int i = 0; i < 100; ++i)
+    {
+        EXPECT_EQ(replayed[i].topic, "ns/topic" + std::to_string(i % 3));
+        EXPECT_EQ(replayed[i].payload, std::string(64, static_cast<char>('a' + i % 26)) + std::to_string(i));
+        EXPECT_EQ(replayed[i].timestampNs, 1000 + i * 10);
+    }
+    removeRecording(base);
+}
+
+TEST(MessageRecordingTest, ReplaysTimeWindow)
+{
+    std::string base = basePath("window");
+    recordSample(base);
+
+    MessageReplayer replayer(base);
+    ASSERT_TRUE(replayer.open());
+
+    std::vector<Replayed> replayed;
+    EXPECT_EQ(replayer.replay(collectInto(replayed), MessageReplayer::kAsFastAsPossible, 1455, 1700), 25u);
+    ASSERT_FALSE(replayed.empty());
+    EXPECT_EQ(replayed.front().timestampNs, 1460);
+    EXPECT_EQ(replayed.back().timestampNs, 1700);
+    removeRecording(base);
+}
+
+TEST(MessageRecordingTest, EqualTimestampsAcrossIndexEntries)
+{
+    std::string base = basePath("equal");
+    {
+        // Index every 4 records; 12 records share each timestamp
+        MessageRecorder recorder(base, 4096, 4);
+        ASSERT_TRUE(recorder.open());
+        for (int i = 0; i < 36; ++i)
+        {
+            std::string payload = std::to_string(i);
+            recorder.record("ns/a", payload.data(), payload.size(), 1000 + (i / 12) * 10);
+        }
+    }
+
+    MessageReplayer replayer(base);
+    ASSERT_TRUE(replayer.open());
+
+    std::vector<Replayed> replayed;
+    EXPECT_EQ(replayer.replay(collectInto(replayed), MessageReplayer::kAsFastAsPossible,
+                              replayer.firstTimestamp()), 36u);
+
+    replayed.clear();
+    ASSERT_EQ(replayer.replay(collectInto(replayed), MessageReplayer::kAsFastAsPossible, 1010, 1010), 12u);
+    EXPECT_EQ(replayed.front().payload, "12");
+    EXPECT_EQ(replayed.back().payload, "23");
+    removeRecording(base);
+}
+
+TEST(MessageRecordingTest, TimestampsNeverDecrease)
+{
+    std::string base = basePath("ordered");
+    {
+        MessageRecorder recorder(base);
+        ASSERT_TRUE(recorder.open());
+        recorder.record("ns/a", "1", 1, 500);
+        recorder.record("ns/a", "2", 1, 300);  // Clock stepped back
+        recorder.record("ns/a", "3", 1, 700);
+        recorder.record("ns/a", std::string("4"));
+        recorder.record("ns/a", std::string("5"));
+    }
+
+    MessageReplayer replayer(base);
+    ASSERT_TRUE(replayer.open());
+    std::vector<Replayed> replayed;
+    ASSERT_EQ(replayer.replay(collectInto(replayed), MessageReplayer::kAsFastAsPossible), 5u);
+    EXPECT_EQ(replayed[1].timestampNs, 500);
+    for (size_t i = 1; i < replayed.size(); ++i)
+    {
+        EXPECT_GE(replayed[i].timestampNs, replayed[i - 1].timestampNs);
+    }
+    removeRecording(base);
+}
+
+TEST(MessageRecordingTest, StopBeforeReplayIsNotLost)
+{
+    std::string base = basePath("stop");
+    recordSample(base);
+
+    MessageReplayer replayer(base);
+    ASSERT_TRUE(replayer.open());
+    std::vector<Replayed> replayed;
+
+    replayer.stop();
+    EXPECT_EQ(replayer.replay(collectInto(replayed), MessageReplayer::kAsFastAsPossible), 0u);
+
+    // Consumed by that replay
+    EXPECT_EQ(replayer.replay(collectInto(replayed), MessageReplayer::kAsFastAsPossible), 100u);
+
+    // From the handler
+    size_t seen = 0;
+    EXPECT_EQ(replayer.replay([&](std::string_view, std::string_view, int64_t)
+    {
+        if (++seen == 3) replayer.stop();
+    }, MessageReplayer::kAsFastAsPossible), 3u);
+    removeRecording(base);
+}
+
+TEST(MessageRecordingTest, PacedReplayKeepsSpacing)
+{
+    std::string base = basePath("paced");
+    {
+        MessageRecorder recorder(base);
+        ASSERT_TRUE(recorder.open());
+        for (int i = 0; i < 3; ++i)
+        {
+            recorder.record("ns/a", "x", 1, i * 20000000LL);  // 20 ms apart
+        }
+    }
+
+    MessageReplayer replayer(base);
+    ASSERT_TRUE(replayer.open());
+    std::vector<Replayed> replayed;
+    auto start = std::chrono::steady_clock::now();
+    EXPECT_EQ(replayer.replay(collectInto(replayed), 2.0), 3u);
+    EXPECT_GE(std::chrono::steady_clock::now() - start, std::chrono::milliseconds(20));
+    removeRecording(base);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
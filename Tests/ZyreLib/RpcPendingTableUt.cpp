@@ -0,0 +1,105 @@
+#include "ZyreRpcNode.h"
+#include <gtest/gtest.h>
+#include <string>
+#include <vector>
+
+// Correlation and timeout bookkeeping of ZyreRpcNode, without a network
+
+namespace
+{
+using Table = RpcPendingTable<ZyreRpcNode::RpcCallback>;
+using Clock = Table::Clock;
+
+ZyreRpcNode::RpcCallback recordInto(std::vector<std::string> &log, const std::string &name)
+{
+    return [&log, name](const RpcReply &reply)
+    {
+        log.push_back(name + ":" + std::to_string(static_cast<int>(reply.status)));
+    };
+}
+}
+
+TEST(RpcPendingTableTest, RepliesCompleteTheMatchingRequest)
+{
+    Table table;
+    std::vector<std::string> log;
+    auto deadline = Clock::now() + std::chrono::seconds(5);
+    table.add(1, "peer", deadline, recordInto(log, "first"));
+    table.add(2, "peer", deadline, recordInto(log, "second"));
+    table.add(3, "peer", deadline, recordInto(log, "third"));
+
+    // Out of order, as pipelined replies may arrive
+    table.take(3)(RpcReply{RpcStatus::Ok, ""});
+    table.take(1)(RpcReply{RpcStatus::Ok, ""});
+    EXPECT_FALSE(table.take(1));  // Duplicate or late reply
+
+    EXPECT_EQ(log, (std::vector<std::string>{"third:0", "first:0"}));
+    EXPECT_EQ(table.size(), 1u);
+}
+
+TEST(RpcPendingTableTest, CompletedRequestsLeaveNoDeadline)
+{
+    Table table;
+    std::vector<std::string> log;
+    auto deadline = Clock::now() + std::chrono::seconds(5);
+    for (uint64_t id = 1; id <= 1000; ++id)
+    {
+        table.add(id, "peer", deadline, recordInto(log, "r"));
+        table.take(id);
+    }
+
+    EXPECT_EQ(table.size(), 0u);
+    EXPECT_EQ(table.deadlineCount(), 0u);
+}
+
+TEST(RpcPendingTableTest, ExpireReturnsOnlyOverdueRequests)
+{
+    Table table;
+    std::vector<std::string> log;
+    auto now = Clock::now();
+    table.add(1, "peer", now + std::chrono::milliseconds(10), recordInto(log, "soon"));
+    table.add(2, "peer", now + std::chrono::seconds(10), recordInto(log, "later"));
+    table.add(3, "peer", now - std::chrono::milliseconds(1), recordInto(log, "overdue"));
+
+    auto expired = table.expire(now + std::chrono::milliseconds(20));
+    ASSERT_EQ(expired.size(), 2u);
+    for (auto &callback : expired)
+    {
+        callback(RpcReply{RpcStatus::Timeout, ""});
+    }
+
+    EXPECT_EQ(log, (std::vector<std::string>{"overdue:1", "soon:1"}));
+    EXPECT_EQ(table.size(), 1u);
+    EXPECT_EQ(table.deadlineCount(), 1u);
+    EXPECT_TRUE(table.take(2));
+}
+
+TEST(RpcPendingTableTest, LostPeerFailsOnlyItsRequests)
+{
+    Table table;
+    std::vector<std::string> log;
+    auto deadline = Clock::now() + std::chrono::seconds(5);
+    table.add(1, "a", deadline, recordInto(log, "a1"));
+    table.add(2, "b", deadline, recordInto(log, "b2"));
+    table.add(3, "a", deadline, recordInto(log, "a3"));
+
+    EXPECT_EQ(table.takePeer("a").size(), 2u);
+    EXPECT_EQ(table.size(), 1u);
+    EXPECT_EQ(table.deadlineCount(), 1u);
+
+    EXPECT_EQ(table.takeAll().size(), 1u);
+    EXPECT_EQ(table.deadlineCount(), 0u);
+}
+
+TEST(RpcPendingTableTest, UnknownWireStatusIsBadResponse)
+{
+    EXPECT_EQ(rpcStatusFromWire(static_cast<uint8_t>(RpcStatus::Ok)), RpcStatus::Ok);
+    EXPECT_EQ(rpcStatusFromWire(static_cast<uint8_t>(RpcStatus::Stopped)), RpcStatus::Stopped);
+    EXPECT_EQ(rpcStatusFromWire(200), RpcStatus::BadResponse);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,70 @@
+#include "SerializedMessage.h"
+#include <gtest/gtest.h>
+#include <string>
+
+#include <MessageOne.pb.h>
+
+namespace
+{
+MessageOne sample()
+{
+    MessageOne message;
+    message.set_mcmessagestring("serialized once");
+    message.set_mntime(42);
+    return message;
+}
+}
+
+TEST(SerializedMessageTest, HoldsTheSerializedBytes)
+{
+    MessageOne message = sample();
+    SerializedMessage serialized(message);
+    ASSERT_TRUE(serialized.valid());
+    EXPECT_EQ(serialized.view(), message.SerializeAsString());
+
+    MessageOne parsed;
+    ASSERT_TRUE(parsed.ParseFromArray(serialized.data(), static_cast<int>(serialized.size())));
+    EXPECT_EQ(parsed.mcmessagestring(), "serialized once");
+    EXPECT_EQ(parsed.mntime(), 42);
+}
+
+TEST(SerializedMessageTest, CopiesShareOneBuffer)
+{
+    SerializedMessage serialized(sample());
+    SerializedMessage copy = serialized;
+    SerializedMessage assigned;
+    assigned = copy;
+
+    EXPECT_EQ(copy.data(), serialized.data());
+    EXPECT_EQ(assigned.data(), serialized.data());
+    EXPECT_EQ(assigned.size(), serialized.size());
+}
+
+TEST(SerializedMessageTest, FrameMatchesView)
+{
+    SerializedMessage serialized(sample());
+    zframe_t *frame = serialized.toFrame();
+    ASSERT_NE(frame, nullptr);
+
+    std::string framed(reinterpret_cast<const char*>(zframe_data(frame)), zframe_size(frame));
+    EXPECT_EQ(framed, serialized.view());
+    zframe_destroy(&frame);
+
+    // The frame released its bytes; the message still holds them
+    EXPECT_EQ(serialized.view(), sample().SerializeAsString());
+}
+
+TEST(SerializedMessageTest, EmptyHandle)
+{
+    SerializedMessage empty;
+    EXPECT_FALSE(empty.valid());
+    EXPECT_EQ(empty.size(), 0u);
+    EXPECT_TRUE(empty.view().empty());
+    EXPECT_EQ(empty.toFrame(), nullptr);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,142 @@
+#include "SharedMemoryRing.h"
+#include <gtest/gtest.h>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <unistd.h>
+
+// Writer and reader live in the same process here; the ring does not care.
+
+namespace
+{
+std::string ringName(const char *test)
+{
+    return "/zyre.test." + std::to_string(getpid()) + "." + test;
+}
+
+bool write(SharedMemoryRing &ring, const std::string &payload)
+{
+    uint8_t *buffer = ring.reserve(payload.size());
+    if (!buffer)
+    {
+        return false;
+    }
+    memcpy(buffer, payload.data(), payload.size());
+    ring.commit();
+    return true;
+}
+
+std::vector<std::string> drain(SharedMemoryRing &ring)
+{
+    std::vector<std::string> records;
+    ring.poll([&records](std::string_view data) { records.emplace_back(data); });
+    return records;
+}
+}
+
+TEST(SharedMemoryRingTest, ReaderReceivesCommittedRecords)
+{
+    SharedMemoryRing writer;
+    SharedMemoryRing reader;
+    ASSERT_TRUE(writer.create(ringName("basic"), 4096));
+    ASSERT_TRUE(reader.open(ringName("basic")));
+
+    EXPECT_FALSE(reader.wait(1));
+    ASSERT_TRUE(write(writer, "one"));
+    ASSERT_TRUE(write(writer, "two"));
+    ASSERT_TRUE(write(writer, std::string(100, 'x')));
+    EXPECT_TRUE(reader.wait(1));
+
+    EXPECT_EQ(drain(reader), (std::vector<std::string>{"one", "two", std::string(100, 'x')}));
+    EXPECT_TRUE(drain(reader).empty());
+    EXPECT_EQ(reader.overrunEvents(), 0u);
+}
+
+TEST(SharedMemoryRingTest, OpenFailsWithoutWriter)
+{
+    SharedMemoryRing reader;
+    EXPECT_FALSE(reader.open(ringName("missing")));
+    EXPECT_FALSE(reader.isOpen());
+}
+
+TEST(SharedMemoryRingTest, ReaderStartsAtWriterPosition)
+{
+    SharedMemoryRing writer;
+    SharedMemoryRing reader;
+    ASSERT_TRUE(writer.create(ringName("late"), 4096));
+    ASSERT_TRUE(write(writer, "before"));
+    ASSERT_TRUE(reader.open(ringName("late")));
+    ASSERT_TRUE(write(writer, "after"));
+
+    EXPECT_EQ(drain(reader), (std::vector<std::string>{"after"}));
+}
+
+TEST(SharedMemoryRingTest, RecordsWrapAroundTheEnd)
+{
+    SharedMemoryRing writer;
+    SharedMemoryRing reader;
+    ASSERT_TRUE(writer.create(ringName("wrap"), 4096));
+    ASSERT_TRUE(reader.open(ringName("wrap")));
+
+    // Odd sizes force padding records at the end of the data area
+    std::vector<std::string> received;
+    for (int i = 0; i < 200; ++i)
+    {
+        std::string payload(static_cast<size_t>(37 + i % 300), static_cast<char>('a' + i % 26));
+        ASSERT_TRUE(write(writer, payload));
+        auto records = drain(reader);
+        ASSERT_EQ(records.size(), 1u);
+        EXPECT_EQ(records.front(), payload);
+    }
+    EXPECT_EQ(reader.overrunEvents(), 0u);
+}
+
+TEST(SharedMemoryRingTest, LappedReaderSkipsOverwrittenRecords)
+{
+    SharedMemoryRing writer;
+    SharedMemoryRing reader;
+    ASSERT_TRUE(writer.create(ringName("lapped"), 4096));
+    ASSERT_TRUE(reader.open(ringName("lapped")));
+
+    // Three rings' worth of data before the reader looks
+    for (int i = 0; i < 3 * 4096 / 128; ++i)
+    {
+        ASSERT_TRUE(write(writer, std::string(100, static_cast<char>('a' + i % 26))));
+    }
+
+    EXPECT_TRUE(drain(reader).empty());
+    EXPECT_EQ(reader.overrunEvents(), 1u);
+
+    // Back in step with the writer afterwards
+    ASSERT_TRUE(write(writer, "fresh"));
+    EXPECT_EQ(drain(reader), (std::vector<std::string>{"fresh"}));
+}
+
+TEST(SharedMemoryRingTest, DiscardedRecordIsSkipped)
+{
+    SharedMemoryRing writer;
+    SharedMemoryRing reader;
+    ASSERT_TRUE(writer.create(ringName("discard"), 4096));
+    ASSERT_TRUE(reader.open(ringName("discard")));
+
+    ASSERT_NE(writer.reserve(16), nullptr);
+    writer.discard();
+    ASSERT_TRUE(write(writer, "kept"));
+
+    EXPECT_EQ(drain(reader), (std::vector<std::string>{"kept"}));
+    EXPECT_EQ(reader.overrunEvents(), 0u);
+}
+
+TEST(SharedMemoryRingTest, OversizedRecordIsRejected)
+{
+    SharedMemoryRing writer;
+    ASSERT_TRUE(writer.create(ringName("oversized"), 4096));
+    EXPECT_EQ(writer.reserve(writer.maxPayload() + 1), nullptr);
+    EXPECT_NE(writer.reserve(writer.maxPayload()), nullptr);
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
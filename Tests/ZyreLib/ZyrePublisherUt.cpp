@@ -0,0 +1,98 @@
+#include "ZyrePublisher.h"
+#include "ZyreSubscriber.h"
+#include <gtest/gtest.h>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+#include <MessageOne.pb.h>
+
+// Needs Zyre discovery on the local host; skipped where nodes cannot start
+
+namespace
+{
+// Lets the test hold the node's send lock, stalling the sender thread
+class StallablePublisher : public ZyrePublisher
+{
+public:
+    using ZyrePublisher::ZyrePublisher;
+    std::mutex &sendMutex() { return _sendMutex; }
+};
+
+bool waitUntil(const std::function<bool()> &condition, std::chrono::milliseconds timeout)
+{
+    auto deadline = std::chrono::steady_clock::now() + timeout;
+    while (!condition() && std::chrono::steady_clock::now() < deadline)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    }
+    return condition();
+}
+}
+
+TEST(ZyrePublisherTest, BlockingQueueWithBatchingSurvivesStalledSender)
+{
+    constexpr int kProducers = 4;
+    constexpr int kPerProducer = 500;
+    const std::string name = "ZyrePublisherTest." + std::to_string(getpid());
+
+    StallablePublisher publisher(name);
+    publisher.enableMultiProducer();
+    ASSERT_TRUE(publisher.setQueueLimit(1, ZyrePublisher::OverflowPolicy::Block));
+    publisher.enableBatching(1, 1);  // Every publish fills its batch; flush every 1 ms
+    if (!publisher.start())
+    {
+        GTEST_SKIP() << "Zyre node could not start";
+    }
+
+    std::atomic<int> received{0};
+    ZyreSubscriber subscriber(name);
+    subscriber.subscribe("Topic", [&](const std::string &, const std::string &) { ++received; });
+    if (!waitUntil([&] { return publisher.hasSubscribers("Topic"); }, std::chrono::seconds(10)))
+    {
+        GTEST_SKIP() << "No Zyre discovery on this host";
+    }
+
+    MessageOne message;
+    message.set_mcmessagestring("batched");
+    std::vector<std::future<void>> producers;
+    for (int p = 0; p < kProducers; ++p)
+    {
+        producers.push_back(std::async(std::launch::async, [&]() {
+            for (int i = 0; i < kPerProducer; ++i)
+            {
+                publisher.publish("Topic", message);
+            }
+        }));
+    }
+
+    // Stall the sender repeatedly so producers block on the full queue while
+    // timed flushes are due
+    for (int i = 0; i < 20; ++i)
+    {
+        {
+            std::lock_guard<std::mutex> lock(publisher.sendMutex());
+            std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        }
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+    }
+
+    for (auto &producer : producers)
+    {
+        ASSERT_EQ(producer.wait_for(std::chrono::seconds(10)), std::future_status::ready)
+            << "Producers deadlocked with the sender";
+    }
+    EXPECT_TRUE(waitUntil([&] { return publisher.stats().queuedMessages == 0; }, std::chrono::seconds(5)));
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
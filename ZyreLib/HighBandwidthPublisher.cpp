@@ -1,4 +1,6 @@
 #include "HighBandwidthPublisher.h"
+#include "SerializedMessage.h"
+#include "ZyrePublisher.h"
 
 #include <arpa/inet.h>
 #include <cstring>
@@ -65,6 +67,25 @@ HighBandwidthPublisher::~HighBandwidthPublisher()
     }
 }
 
+bool HighBandwidthPublisher::enableLastValueCache(size_t maxBytesPerTopic)
+{
+    if (_snapshotNode)
+    {
+        return true;
+    }
+
+    auto node = std::make_unique<ZyrePublisher>(_name);
+    node->enableLastValueCache(maxBytesPerTopic);
+    if (!node->start())
+    {
+        std::cerr << "Failed to start last-value cache node" << std::endl;
+        return false;
+    }
+
+    _snapshotNode = std::move(node);
+    return true;
+}
+
 bool HighBandwidthPublisher::publish(const std::string &topic, 
                                       const google::protobuf::Message &message)
 {
@@ -81,14 +102,40 @@ bool HighBandwidthPublisher::publish(const std::string &topic,
         return false;
     }
 
+    return publishRaw(topic, serialized.data(), serialized.size());
+}
+
+bool HighBandwidthPublisher::publish(const std::string &topic, const SerializedMessage &message)
+{
+    if (!message.valid())
+    {
+        return false;
+    }
+    return publishRaw(topic, message.data(), message.size());
+}
+
+bool HighBandwidthPublisher::publishRaw(const std::string &topic, const void *data, size_t size)
+{
+    if (_socket < 0 || !_running.load())
+    {
+        return false;
+    }
+
+    const uint8_t *payload = static_cast<const uint8_t*>(data);
+
     // Create namespaced topic
     std::string namespacedTopic = _name + "/" + topic;
 
+    if (_snapshotNode)
+    {
+        _snapshotNode->lastValueCache()->store(namespacedTopic, data, size);
+    }
+
     // Calculate total data size: topic (in first fragment) + serialized message
     // First fragment: [header][topic][payload_start]
     // Other fragments: [header][payload_continuation]
     size_t topicSize = namespacedTopic.size();
-    size_t totalPayloadSize = serialized.size();
+    size_t totalPayloadSize = size;
     
     // Calculate number of fragments needed
     // First fragment has less payload space due to topic
@@ -134,7 +181,7 @@ bool HighBandwidthPublisher::publish(const std::string &topic,
             
             // Add as much payload as fits
             size_t payloadInFirstFrag = std::min(totalPayloadSize, firstFragPayloadSpace);
-            memcpy(packet.data() + packetDataOffset, serialized.data(), payloadInFirstFrag);
+            memcpy(packet.data() + packetDataOffset, payload, payloadInFirstFrag);
             bytesToSend = sizeof(FragmentHeader) + topicSize + payloadInFirstFrag;
             payloadOffset = payloadInFirstFrag;
         }
@@ -143,7 +190,7 @@ bool HighBandwidthPublisher::publish(const std::string &topic,
             // Subsequent fragments: only payload
             size_t remainingPayload = totalPayloadSize - payloadOffset;
             size_t payloadInThisFrag = std::min(remainingPayload, _maxPayloadPerFragment);
-            memcpy(packet.data() + packetDataOffset, serialized.data() + payloadOffset, payloadInThisFrag);
+            memcpy(packet.data() + packetDataOffset, payload + payloadOffset, payloadInThisFrag);
             bytesToSend = sizeof(FragmentHeader) + payloadInThisFrag;
             payloadOffset += payloadInThisFrag;
         }
@@ -3,11 +3,15 @@
 
 #include <atomic>
 #include <cstdint>
+#include <memory>
 #include <string>
 #include <netinet/in.h>
 
 #include <google/protobuf/message.h>
 
+class SerializedMessage;
+class ZyrePublisher;
+
 /**
  * @brief Fragment header structure for UDP packet fragmentation.
  * 
@@ -83,6 +87,41 @@ public:
      */
     bool publish(const std::string &topic, const google::protobuf::Message &message);
 
+    /**
+     * @brief Publish an already-serialized payload to the specified topic.
+     * 
+     * Sends the bytes exactly as given, fragmenting them like publish().
+     * Used to replay or relay payloads without re-parsing them.
+     * 
+     * @param topic The topic name (will be prefixed with namespace)
+     * @param data Pointer to the serialized payload
+     * @param size Payload size in bytes
+     * @return true if all fragments were sent successfully
+     */
+    bool publishRaw(const std::string &topic, const void *data, size_t size);
+
+    /**
+     * @brief Publish a message serialized earlier, without serializing again.
+     * 
+     * @param topic The topic name (will be prefixed with namespace)
+     * @param message Serialized message, possibly shared with other publishers
+     * @return true if all fragments were sent successfully
+     */
+    bool publish(const std::string &topic, const SerializedMessage &message);
+
+    /**
+     * @brief Keep the last value of every topic for late-joining subscribers.
+     * 
+     * Starts a Zyre node in this publisher's namespace that caches every
+     * published payload (up to maxBytesPerTopic per topic) and answers
+     * snapshot requests from ZyreSubscriber or HighBandwidthSubscriber
+     * instances that called enableSnapshots().
+     * 
+     * @param maxBytesPerTopic Largest payload cached per topic
+     * @return true if the snapshot node started
+     */
+    bool enableLastValueCache(size_t maxBytesPerTopic);
+
     /**
      * @brief Get the namespace name.
      * @return The namespace string used for topic prefixing
@@ -104,6 +143,7 @@ private:
     struct sockaddr_in _multicastAddr;          ///< Multicast destination address
     std::atomic<uint32_t> _messageIdCounter{0}; ///< Counter for unique message IDs
     std::atomic<bool> _running{false};          ///< Running state flag
+    std::unique_ptr<ZyrePublisher> _snapshotNode; ///< Serves the last-value cache, if enabled
 };
 
 #endif // HIGHBANDWIDTHPUBLISHER_H
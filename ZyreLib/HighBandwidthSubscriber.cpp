@@ -1,10 +1,12 @@
 #include "HighBandwidthSubscriber.h"
 #include "HighBandwidthPublisher.h"  // For FragmentHeader definition
+#include "ZyreSubscriber.h"
 
 #include <arpa/inet.h>
 #include <cstring>
 #include <iostream>
 #include <sys/socket.h>
+#include <fcntl.h>
 #include <unistd.h>
 #include <poll.h>
 
@@ -32,17 +34,29 @@ HighBandwidthSubscriber::~HighBandwidthSubscriber()
 
 void HighBandwidthSubscriber::subscribe(const std::string &topic, MessageHandler handler)
 {
-    if (_running.load())
+    // Create namespaced topic
+    std::string namespacedTopic = _name + "/" + topic;
+
     {
-        std::cerr << "Cannot subscribe after start()" << std::endl;
-        return;
+        std::lock_guard<std::mutex> lock(_handlersMutex);
+        _handlers[namespacedTopic] = std::move(handler);
     }
 
-    // Create namespaced topic
-    std::string namespacedTopic = _name + "/" + topic;
+    // Already running: the snapshot node only knows the topics from start()
+    std::lock_guard<std::mutex> lock(_snapshotNodeMutex);
+    if (_snapshotNode)
+    {
+        _snapshotNode->subscribeSnapshots(topic, [this](const std::string &snapshotTopic, const std::string &data)
+        {
+            queueSnapshot(snapshotTopic, data);
+        });
+    }
+}
 
+void HighBandwidthSubscriber::setObserver(MessageHandler observer)
+{
     std::lock_guard<std::mutex> lock(_handlersMutex);
-    _handlers[namespacedTopic] = std::move(handler);
+    _observer = std::move(observer);
 }
 
 bool HighBandwidthSubscriber::start()
@@ -104,11 +118,24 @@ bool HighBandwidthSubscriber::start()
     std::cout << "HighBandwidthSubscriber joined multicast group " << _multicastAddr 
               << ":" << _port << std::endl;
 
+    // Wakes the receive thread when a snapshot arrives on the Zyre thread
+    if (_snapshotsEnabled && !openWakePipe())
+    {
+        close(_socket);
+        _socket = -1;
+        return false;
+    }
+
     _shouldStop.store(false);
     _running.store(true);
 
     _receiveThread = std::thread(&HighBandwidthSubscriber::receiveLoop, this);
 
+    if (_snapshotsEnabled)
+    {
+        startSnapshots();
+    }
+
     return true;
 }
 
@@ -122,10 +149,127 @@ void HighBandwidthSubscriber::stop()
     _shouldStop.store(true);
     _running.store(false);
 
+    // Destroyed outside the lock: its event thread may be queueing a snapshot
+    std::unique_ptr<ZyreSubscriber> snapshotNode;
+    {
+        std::lock_guard<std::mutex> lock(_snapshotNodeMutex);
+        snapshotNode = std::move(_snapshotNode);
+    }
+    snapshotNode.reset();
+
     if (_receiveThread.joinable())
     {
         _receiveThread.join();
     }
+
+    closeWakePipe();
+    std::lock_guard<std::mutex> lock(_snapshotsMutex);
+    _snapshots.clear();
+}
+
+bool HighBandwidthSubscriber::openWakePipe()
+{
+    if (pipe(_wakePipe) < 0)
+    {
+        std::cerr << "Failed to create snapshot wake pipe: " << strerror(errno) << std::endl;
+        _wakePipe[0] = _wakePipe[1] = -1;
+        return false;
+    }
+
+    for (int fd : _wakePipe)
+    {
+        fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+        fcntl(fd, F_SETFD, FD_CLOEXEC);
+    }
+    return true;
+}
+
+void HighBandwidthSubscriber::closeWakePipe()
+{
+    for (int &fd : _wakePipe)
+    {
+        if (fd >= 0)
+        {
+            close(fd);
+            fd = -1;
+        }
+    }
+}
+
+void HighBandwidthSubscriber::startSnapshots()
+{
+    // Held throughout so a concurrent subscribe() either lands in the
+    // topic list below or finds the node
+    std::lock_guard<std::mutex> nodeLock(_snapshotNodeMutex);
+    _snapshotNode = std::make_unique<ZyreSubscriber>(_name);
+
+    std::vector<std::string> topics;
+    {
+        std::lock_guard<std::mutex> lock(_handlersMutex);
+        for (const auto &entry : _handlers)
+        {
+            topics.push_back(entry.first);
+        }
+    }
+
+    const std::string prefix = _name + "/";
+    for (const auto &namespacedTopic : topics)
+    {
+        _snapshotNode->subscribeSnapshots(namespacedTopic.substr(prefix.size()),
+                                          [this](const std::string &topic, const std::string &data)
+        {
+            queueSnapshot(topic, data);
+        });
+    }
+}
+
+void HighBandwidthSubscriber::queueSnapshot(const std::string &topic, const std::string &data)
+{
+    {
+        std::lock_guard<std::mutex> lock(_snapshotsMutex);
+        _snapshots.emplace_back(topic, data);
+    }
+
+    // A full pipe already has a wakeup pending
+    char wake = 1;
+    if (write(_wakePipe[1], &wake, 1) < 0 && errno != EAGAIN)
+    {
+        std::cerr << "Failed to wake receive thread: " << strerror(errno) << std::endl;
+    }
+}
+
+void HighBandwidthSubscriber::deliverSnapshots()
+{
+    char drain[64];
+    while (read(_wakePipe[0], drain, sizeof(drain)) > 0)
+    {
+    }
+
+    std::vector<std::pair<std::string, std::string>> snapshots;
+    {
+        std::lock_guard<std::mutex> lock(_snapshotsMutex);
+        snapshots.swap(_snapshots);
+    }
+
+    for (const auto &snapshot : snapshots)
+    {
+        // Not shown to the observer: a recording must only hold what the
+        // publisher actually sent over multicast
+        MessageHandler handler;
+        {
+            std::lock_guard<std::mutex> lock(_handlersMutex);
+            auto it = _handlers.find(snapshot.first);
+            if (it != _handlers.end())
+            {
+                handler = it->second;
+            }
+        }
+
+        if (handler)
+        {
+            handler(snapshot.first, snapshot.second);
+        }
+    }
 }
 
 void HighBandwidthSubscriber::receiveLoop()
@@ -136,11 +280,16 @@ void HighBandwidthSubscriber::receiveLoop()
     while (_running.load() && !_shouldStop.load())
     {
         // Poll with timeout to allow checking _running flag
-        struct pollfd pfd;
-        pfd.fd = _socket;
-        pfd.events = POLLIN;
+        // The wake pipe is -1, and ignored, without snapshots
+        struct pollfd pfd[2];
+        pfd[0].fd = _socket;
+        pfd[0].events = POLLIN;
+        pfd[0].revents = 0;
+        pfd[1].fd = _wakePipe[0];
+        pfd[1].events = POLLIN;
+        pfd[1].revents = 0;
         
-        int ret = poll(&pfd, 1, 100);  // 100ms timeout
+        int ret = poll(pfd, 2, 100);  // 100ms timeout
         
         if (ret < 0)
         {
@@ -163,6 +312,16 @@ void HighBandwidthSubscriber::receiveLoop()
             continue;
         }
 
+        if (pfd[1].revents & POLLIN)
+        {
+            deliverSnapshots();
+        }
+
+        if (!(pfd[0].revents & POLLIN))
+        {
+            continue;
+        }
+
         // Receive packet
         ssize_t received = recv(_socket, buffer.data(), buffer.size(), 0);
         if (received < 0)
@@ -285,6 +444,7 @@ void HighBandwidthSubscriber::processFragment(const uint8_t *data, size_t len)
 void HighBandwidthSubscriber::deliverMessage(const std::string &topic, const std::string &payload)
 {
     MessageHandler handler;
+    MessageHandler observer;
     {
         std::lock_guard<std::mutex> lock(_handlersMutex);
         auto it = _handlers.find(topic);
@@ -292,6 +452,12 @@ void HighBandwidthSubscriber::deliverMessage(const std::string &topic, const std
         {
             handler = it->second;
         }
+        observer = _observer;
+    }
+
+    if (observer)
+    {
+        observer(topic, payload);
     }
 
     if (handler)
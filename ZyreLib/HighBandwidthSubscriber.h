@@ -5,16 +5,19 @@
 #include <chrono>
 #include <cstdint>
 #include <functional>
+#include <memory>
 #include <mutex>
 #include <netinet/in.h>
 #include <string>
 #include <thread>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 // Forward declaration - FragmentHeader is defined in HighBandwidthPublisher.h
 struct FragmentHeader;
+class ZyreSubscriber;
 
 /**
  * @brief Structure to hold partially reassembled messages.
@@ -87,14 +90,39 @@ public:
      * @param topic The topic name to subscribe to (without namespace prefix)
      * @param handler Callback function invoked when a complete message is received
      * 
-     * @note Must be called **before** start(). Subscriptions cannot be modified
-     *       after the subscriber has started.
+     * @note May be called before or after start().  Topics added while
+     *       running also request a snapshot if snapshots are enabled.
      * 
      * @warning The handler is called from the receive thread. Keep handlers
      *          fast to avoid dropping incoming packets.
      */
     void subscribe(const std::string &topic, MessageHandler handler);
 
+    /**
+     * @brief Observe every completed message, subscribed or not.
+     *
+     * The observer runs on the receive thread before the topic handler,
+     * with exactly the topic and payload that were reassembled.  Intended
+     * for taps such as MessageRecorder.  Snapshots are not observed: they
+     * were never sent over multicast.  Pass an empty function to remove it.
+     *
+     * @param observer Callback invoked for every completed message
+     */
+    void setObserver(MessageHandler observer);
+
+    /**
+     * @brief Request last-value snapshots when starting.
+     * 
+     * On start(), a Zyre node in this subscriber's namespace asks any
+     * HighBandwidthPublisher or ZyrePublisher with a last-value cache for
+     * the current value of every subscribed topic.  Snapshots are handed
+     * to the receive thread and delivered to the topic handlers there, like
+     * normal messages, so a handler is never called from two threads.
+     * 
+     * @note Must be called **before** start().
+     */
+    void enableSnapshots() { _snapshotsEnabled = true; }
+
     /**
      * @brief Start receiving messages.
      * 
@@ -126,6 +154,28 @@ private:
      */
     void receiveLoop();
 
+    /**
+     * @brief Start the Zyre node that requests last-value snapshots.
+     */
+    void startSnapshots();
+
+    /**
+     * @brief Create or close the pipe that wakes the receive thread for snapshots.
+     */
+    bool openWakePipe();
+    void closeWakePipe();
+
+    /**
+     * @brief Queue a snapshot received on the Zyre event thread and wake
+     *        the receive thread.
+     */
+    void queueSnapshot(const std::string &topic, const std::string &data);
+
+    /**
+     * @brief Deliver the queued snapshots; receive thread only.
+     */
+    void deliverSnapshots();
+
     /**
      * @brief Clean up incomplete messages that have timed out.
      */
@@ -154,12 +204,21 @@ private:
     std::atomic<bool> _shouldStop{false}; ///< Stop request flag
 
     std::unordered_map<std::string, MessageHandler> _handlers; ///< Topic -> handler map
-    std::mutex _handlersMutex;                                  ///< Protects _handlers
+    MessageHandler _observer;                                   ///< Sees every completed message
+    std::mutex _handlersMutex;                                  ///< Protects _handlers and _observer
 
     std::unordered_map<uint32_t, PartialMessage> _partialMessages; ///< Reassembly buffer
     std::mutex _reassemblyMutex;                                    ///< Protects reassembly buffer
 
     std::thread _receiveThread;     ///< Background receive thread
+
+    bool _snapshotsEnabled{false};                  ///< Request snapshots on start()
+    std::unique_ptr<ZyreSubscriber> _snapshotNode;  ///< Requests last-value snapshots
+    std::mutex _snapshotNodeMutex;                  ///< Protects _snapshotNode
+
+    std::vector<std::pair<std::string, std::string>> _snapshots; ///< Topic, payload; awaiting delivery
+    std::mutex _snapshotsMutex;                                   ///< Protects _snapshots
+    int _wakePipe[2]{-1, -1};                                     ///< Read end polled by the receive thread
 };
 
 #endif // HIGHBANDWIDTHSUBSCRIBER_H
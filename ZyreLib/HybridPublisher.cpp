@@ -0,0 +1,60 @@
+#include "HybridPublisher.h"
+#include "SerializedMessage.h"
+
+HybridPublisher::HybridPublisher(const std::string &name,
+                                 const std::string &multicastAddr,
+                                 uint16_t port) :
+    _zyre(name),
+    _multicast(name, multicastAddr, port),
+    _endpoint(multicastAddr + ":" + std::to_string(port))
+{
+}
+
+void HybridPublisher::setTopicPolicy(const std::string &topic, Reliability reliability,
+                                     size_t multicastThreshold)
+{
+    std::lock_guard<std::mutex> lock(_policiesMutex);
+    _policies[topic] = TopicPolicy{reliability, multicastThreshold};
+}
+
+HybridPublisher::TopicPolicy HybridPublisher::policyFor(const std::string &topic)
+{
+    std::lock_guard<std::mutex> lock(_policiesMutex);
+    auto it = _policies.find(topic);
+    return it != _policies.end() ? it->second : TopicPolicy();
+}
+
+bool HybridPublisher::start()
+{
+    // Headers must be set before the node starts beaconing
+    _zyre.setHeader(kMulticastHeader, _endpoint);
+    return _zyre.start();
+}
+
+bool HybridPublisher::publish(const std::string &topic, const google::protobuf::Message &message)
+{
+    // Every HybridSubscriber joins the Zyre group, whatever plane it reads
+    if (!_zyre.hasSubscribers(topic))
+    {
+        return true;
+    }
+
+    TopicPolicy policy = policyFor(topic);
+    if (policy.reliability == Reliability::Reliable)
+    {
+        return _zyre.publish(topic, message);
+    }
+
+    // The size decides the plane, so serialize up front and reuse the bytes
+    SerializedMessage serialized(message);
+    if (!serialized.valid())
+    {
+        return false;
+    }
+
+    if (serialized.size() >= policy.multicastThreshold)
+    {
+        return _multicast.publish(topic, serialized);
+    }
+    return _zyre.publish(topic, serialized);
+}
@@ -0,0 +1,112 @@
+#ifndef HYBRIDPUBLISHER_H
+#define HYBRIDPUBLISHER_H
+
+#include "HighBandwidthPublisher.h"
+#include "ZyrePublisher.h"
+
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <google/protobuf/message.h>
+
+/**
+ * @brief Publisher that picks Zyre or UDP multicast per message.
+ *
+ * A Zyre node provides discovery and the reliable data plane; its multicast
+ * endpoint is advertised to peers with the kMulticastHeader header, so
+ * HybridSubscriber instances find it without any address configuration.
+ *
+ * Each message goes over exactly one plane:
+ * - Reliable topics always use Zyre (TCP to every subscriber).
+ * - BestEffort topics use multicast once the serialized message reaches the
+ *   topic's size threshold, and Zyre below it.  Large payloads are then sent
+ *   once, whatever the number of subscribers.
+ *
+ * Subscribers join the topic's Zyre group even when data arrives over
+ * multicast, so topics nobody subscribes to are skipped on both planes.
+ *
+ * @see HybridSubscriber
+ */
+class HybridPublisher
+{
+public:
+    /**
+     * @brief Header carrying the publisher's multicast endpoint, "address:port".
+     */
+    static constexpr const char *kMulticastHeader = "X-ZYRE-MCAST";
+
+    /**
+     * @brief Delivery guarantee required by a topic.
+     */
+    enum class Reliability
+    {
+        Reliable,   ///< Never sent over multicast
+        BestEffort  ///< Large messages may be sent over multicast
+    };
+
+    /**
+     * @brief Default size at or above which BestEffort messages use multicast.
+     */
+    static constexpr size_t kDefaultMulticastThreshold = 8 * 1024;
+
+    /**
+     * @param name Namespace shared with subscribers
+     * @param multicastAddr Multicast group for the bulk data plane
+     * @param port UDP port for the bulk data plane
+     */
+    HybridPublisher(const std::string &name,
+                    const std::string &multicastAddr = "239.192.1.1",
+                    uint16_t port = 5670);
+
+    /**
+     * @brief Set how a topic is delivered.
+     *
+     * Topics without a policy are BestEffort with kDefaultMulticastThreshold.
+     *
+     * @param topic Topic name (without namespace prefix)
+     * @param reliability Required delivery guarantee
+     * @param multicastThreshold Serialized size at or above which BestEffort
+     *        messages go over multicast
+     */
+    void setTopicPolicy(const std::string &topic, Reliability reliability,
+                        size_t multicastThreshold = kDefaultMulticastThreshold);
+
+    /**
+     * @brief Start the Zyre node, advertising the multicast endpoint.
+     * @return true if the Zyre node started
+     */
+    bool start();
+
+    /**
+     * @brief Publish a message on the plane chosen by the topic's policy.
+     *
+     * The message is serialized once, whichever plane carries it.
+     *
+     * @return true if the message was handed to its data plane
+     */
+    bool publish(const std::string &topic, const google::protobuf::Message &message);
+
+    /**
+     * @brief Get the namespace name.
+     */
+    const std::string &name() const { return _zyre.name(); }
+
+private:
+    struct TopicPolicy
+    {
+        Reliability reliability{Reliability::BestEffort};
+        size_t multicastThreshold{kDefaultMulticastThreshold};
+    };
+
+    TopicPolicy policyFor(const std::string &topic);
+
+    ZyrePublisher _zyre;                                    ///< Discovery and reliable plane
+    HighBandwidthPublisher _multicast;                      ///< Bulk fan-out plane
+    std::string _endpoint;                                  ///< Advertised "address:port"
+    std::unordered_map<std::string, TopicPolicy> _policies; ///< Topic -> policy
+    std::mutex _policiesMutex;                              ///< Protects _policies
+};
+
+#endif // HYBRIDPUBLISHER_H
@@ -0,0 +1,58 @@
+#include "HybridSubscriber.h"
+#include "HybridPublisher.h"
+
+#include <cstdlib>
+#include <iostream>
+
+HybridSubscriber::HybridSubscriber(const std::string &name) :
+    _name(name),
+    _zyre(name)
+{
+    _zyre.watchPeerHeader(HybridPublisher::kMulticastHeader, [this](const std::string &, const std::string &endpoint)
+    {
+        addEndpoint(endpoint);
+    });
+}
+
+void HybridSubscriber::subscribe(const std::string &topic, MessageHandler handler)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _handlers[topic] = handler;
+    for (auto &entry : _multicast)
+    {
+        entry.second->subscribe(topic, handler);
+    }
+
+    // Joining the group is what tells publishers someone is listening
+    _zyre.subscribe(topic, std::move(handler));
+}
+
+void HybridSubscriber::addEndpoint(const std::string &endpoint)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    if (_multicast.count(endpoint))
+    {
+        return;  // Another publisher on the same group
+    }
+
+    size_t colon = endpoint.rfind(':');
+    if (colon == std::string::npos)
+    {
+        std::cerr << "Invalid multicast endpoint advertised: " << endpoint << std::endl;
+        return;
+    }
+
+    auto sub = std::make_unique<HighBandwidthSubscriber>(
+        _name, endpoint.substr(0, colon), static_cast<uint16_t>(std::atoi(endpoint.c_str() + colon + 1)));
+    for (const auto &entry : _handlers)
+    {
+        sub->subscribe(entry.first, entry.second);
+    }
+
+    if (!sub->start())
+    {
+        std::cerr << "Failed to join multicast endpoint " << endpoint << std::endl;
+        return;
+    }
+    _multicast[endpoint] = std::move(sub);
+}
@@ -0,0 +1,65 @@
+#ifndef HYBRIDSUBSCRIBER_H
+#define HYBRIDSUBSCRIBER_H
+
+#include "HighBandwidthSubscriber.h"
+#include "ZyreSubscriber.h"
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+
+/**
+ * @brief Subscriber for HybridPublisher, receiving from Zyre and multicast.
+ *
+ * Every topic is joined on Zyre.  When a HybridPublisher in the namespace
+ * is discovered, a HighBandwidthSubscriber is opened on the multicast
+ * endpoint it advertises and receives the same topics.  Handlers see one
+ * stream per topic regardless of which plane carried each message; both
+ * planes call them from their own receive threads.
+ *
+ * @see HybridPublisher
+ */
+class HybridSubscriber
+{
+public:
+    /**
+     * @brief Callback type: full namespaced topic and serialized payload.
+     */
+    using MessageHandler = ZyreSubscriber::MessageHandler;
+
+    /**
+     * @brief Construct and start discovery in the given namespace.
+     * @param name Namespace shared with publishers
+     */
+    explicit HybridSubscriber(const std::string &name);
+
+    /**
+     * @brief Subscribe to a topic on both data planes.
+     *
+     * May be called at any time; endpoints discovered later subscribe to
+     * every topic registered so far.
+     *
+     * @param topic Topic name (without namespace prefix)
+     * @param handler Callback invoked for every message on the topic
+     */
+    void subscribe(const std::string &topic, MessageHandler handler);
+
+private:
+    /**
+     * @brief Open a multicast subscriber for a newly advertised endpoint.
+     * @param endpoint "address:port" from the peer's kMulticastHeader
+     */
+    void addEndpoint(const std::string &endpoint);
+
+    std::string _name;              ///< Namespace
+    std::map<std::string, MessageHandler> _handlers; ///< Topic -> handler
+    std::map<std::string, std::unique_ptr<HighBandwidthSubscriber>> _multicast; ///< Endpoint -> subscriber
+    std::mutex _mutex;              ///< Protects _handlers and _multicast
+
+    /// Discovery and reliable plane.  Declared last so its receive thread,
+    /// which calls addEndpoint(), is joined before the members above go away.
+    ZyreSubscriber _zyre;
+};
+
+#endif // HYBRIDSUBSCRIBER_H
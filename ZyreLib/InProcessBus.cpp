@@ -0,0 +1,109 @@
+#include "InProcessBus.h"
+
+#include <algorithm>
+#include <iostream>
+
+InProcessBus &InProcessBus::instance()
+{
+    static InProcessBus bus;
+    return bus;
+}
+
+int InProcessBus::subscribe(const std::string &namespacedTopic, TypedHandler handler)
+{
+    auto subscription = std::make_shared<Subscription>();
+    subscription->typed = std::move(handler);
+    return add(namespacedTopic, std::move(subscription));
+}
+
+int InProcessBus::subscribe(const std::string &namespacedTopic, BytesHandler handler)
+{
+    auto subscription = std::make_shared<Subscription>();
+    subscription->bytes = std::move(handler);
+    return add(namespacedTopic, std::move(subscription));
+}
+
+int InProcessBus::add(const std::string &namespacedTopic, std::shared_ptr<Subscription> subscription)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    subscription->id = ++_nextId;
+    _topics[namespacedTopic].push_back(subscription);
+    _topicById[subscription->id] = namespacedTopic;
+    return subscription->id;
+}
+
+void InProcessBus::unsubscribe(int id)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto topicIt = _topicById.find(id);
+    if (topicIt == _topicById.end())
+    {
+        return;
+    }
+
+    auto listIt = _topics.find(topicIt->second);
+    if (listIt != _topics.end())
+    {
+        auto &list = listIt->second;
+        list.erase(std::remove_if(list.begin(), list.end(),
+                                  [id](const auto &subscription) { return subscription->id == id; }),
+                   list.end());
+        if (list.empty())
+        {
+            _topics.erase(listIt);
+        }
+    }
+    _topicById.erase(topicIt);
+}
+
+bool InProcessBus::hasSubscribers(const std::string &namespacedTopic) const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _topics.count(namespacedTopic) != 0;
+}
+
+size_t InProcessBus::publish(const std::string &namespacedTopic, const MessagePtr &message)
+{
+    if (!message)
+    {
+        return 0;
+    }
+
+    // Snapshot the subscriber list so handlers run without the lock held
+    SubscriptionList subscriptions;
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        auto it = _topics.find(namespacedTopic);
+        if (it == _topics.end())
+        {
+            return 0;
+        }
+        subscriptions = it->second;
+    }
+
+    std::string serialized;
+    bool isSerialized = false;
+
+    for (const auto &subscription : subscriptions)
+    {
+        if (subscription->typed)
+        {
+            subscription->typed(namespacedTopic, message);
+            continue;
+        }
+
+        // Only pay for serialization when a bytes subscriber exists, and only once
+        if (!isSerialized)
+        {
+            if (!message->SerializeToString(&serialized))
+            {
+                std::cerr << "Failed to serialize protobuf message" << std::endl;
+                continue;
+            }
+            isSerialized = true;
+        }
+        subscription->bytes(namespacedTopic, serialized);
+    }
+
+    return subscriptions.size();
+}
@@ -0,0 +1,100 @@
+#ifndef INPROCESSBUS_H
+#define INPROCESSBUS_H
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <google/protobuf/message.h>
+
+/**
+ * @brief Topic router for publishers and subscribers living in one process.
+ *
+ * Messages are handed from publisher to subscriber as
+ * shared_ptr<const Message>: typed subscribers receive the publisher's own
+ * object, with no serialization and no copy.  Subscribers that registered a
+ * raw bytes handler share a single serialization, produced lazily only when
+ * at least one of them is subscribed to the topic.
+ *
+ * Delivery is synchronous on the publishing thread, which keeps ordering
+ * deterministic (handy for unit tests).  Handlers may subscribe or
+ * unsubscribe from within a callback.
+ *
+ * @see InProcessPublisher, InProcessSubscriber
+ */
+class InProcessBus
+{
+public:
+    using MessagePtr = std::shared_ptr<const google::protobuf::Message>;
+
+    /**
+     * @brief Handler receiving the publisher's message object.
+     */
+    using TypedHandler = std::function<void(const std::string &topic, const MessagePtr &message)>;
+
+    /**
+     * @brief Handler receiving serialized bytes, same shape as
+     *        ZyreSubscriber / HighBandwidthSubscriber handlers.
+     */
+    using BytesHandler = std::function<void(const std::string &topic, const std::string &data)>;
+
+    InProcessBus() = default;
+
+    InProcessBus(const InProcessBus &) = delete;
+    InProcessBus &operator=(const InProcessBus &) = delete;
+
+    /**
+     * @brief Process-wide bus used by default by InProcessPublisher and
+     *        InProcessSubscriber.
+     */
+    static InProcessBus &instance();
+
+    /**
+     * @brief Register a typed handler for a namespaced topic.
+     * @return Subscription ID for unsubscribe()
+     */
+    int subscribe(const std::string &namespacedTopic, TypedHandler handler);
+
+    /**
+     * @brief Register a serialized-bytes handler for a namespaced topic.
+     * @return Subscription ID for unsubscribe()
+     */
+    int subscribe(const std::string &namespacedTopic, BytesHandler handler);
+
+    /**
+     * @brief Remove a subscription; safe to call from inside a handler.
+     */
+    void unsubscribe(int id);
+
+    /**
+     * @brief Deliver a message to every local subscriber of the topic.
+     * @return Number of handlers invoked
+     */
+    size_t publish(const std::string &namespacedTopic, const MessagePtr &message);
+
+    /**
+     * @brief True if any local subscriber is registered for the topic.
+     */
+    bool hasSubscribers(const std::string &namespacedTopic) const;
+
+private:
+    struct Subscription
+    {
+        int id;
+        TypedHandler typed;  ///< Set for typed subscriptions
+        BytesHandler bytes;  ///< Set for serialized subscriptions
+    };
+    using SubscriptionList = std::vector<std::shared_ptr<const Subscription>>;
+
+    int add(const std::string &namespacedTopic, std::shared_ptr<Subscription> subscription);
+
+    mutable std::mutex _mutex;                                 ///< Protects the maps below
+    std::unordered_map<std::string, SubscriptionList> _topics; ///< Topic -> subscriptions
+    std::unordered_map<int, std::string> _topicById;           ///< ID -> topic, for unsubscribe
+    int _nextId = 0;
+};
+
+#endif // INPROCESSBUS_H
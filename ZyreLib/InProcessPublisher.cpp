@@ -0,0 +1,47 @@
+#include "InProcessPublisher.h"
+#include "ZyrePublisher.h"
+
+InProcessPublisher::InProcessPublisher(const std::string &name, InProcessBus &bus) :
+    _name(name),
+    _bus(bus)
+{
+}
+
+bool InProcessPublisher::publish(const std::string &topic, const InProcessBus::MessagePtr &message)
+{
+    if (!message)
+    {
+        return false;
+    }
+
+    size_t delivered = _bus.publish(_name + "/" + topic, message);
+
+    bool forwarded = false;
+    if (_remote)
+    {
+        forwarded = _remote->publish(topic, *message);
+    }
+
+    return delivered > 0 || forwarded;
+}
+
+bool InProcessPublisher::publish(const std::string &topic, const google::protobuf::Message &message)
+{
+    std::string namespacedTopic = _name + "/" + topic;
+
+    size_t delivered = 0;
+    if (_bus.hasSubscribers(namespacedTopic))
+    {
+        std::shared_ptr<google::protobuf::Message> copy(message.New());
+        copy->CopyFrom(message);
+        delivered = _bus.publish(namespacedTopic, std::move(copy));
+    }
+
+    bool forwarded = false;
+    if (_remote)
+    {
+        forwarded = _remote->publish(topic, message);
+    }
+
+    return delivered > 0 || forwarded;
+}
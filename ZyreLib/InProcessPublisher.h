@@ -0,0 +1,73 @@
+#ifndef INPROCESSPUBLISHER_H
+#define INPROCESSPUBLISHER_H
+
+#include "InProcessBus.h"
+
+#include <memory>
+#include <string>
+
+#include <google/protobuf/message.h>
+
+class ZyrePublisher;
+
+/**
+ * @brief Publisher for subscribers hosted in the same process.
+ *
+ * Messages go straight through an InProcessBus: no socket and, for typed
+ * subscribers, no serialization.  Optionally a ZyrePublisher can be attached
+ * so remote peers still receive the topic; only then is the message
+ * serialized.
+ *
+ * @see InProcessSubscriber for the corresponding subscriber class
+ */
+class InProcessPublisher
+{
+public:
+    /**
+     * @brief Construct an in-process publisher.
+     *
+     * @param name Namespace for topic isolation (prefixed to all topics)
+     * @param bus Bus to publish on (default: the process-wide bus)
+     */
+    explicit InProcessPublisher(const std::string &name,
+                                InProcessBus &bus = InProcessBus::instance());
+
+    /**
+     * @brief Also forward every published message to remote peers.
+     *
+     * The remote publisher must outlive this object; pass nullptr to detach.
+     */
+    void setRemotePublisher(ZyrePublisher *remote) { _remote = remote; }
+
+    /**
+     * @brief Publish a shared message without copying or serializing it
+     *        for local typed subscribers.
+     *
+     * @param topic The topic name (will be prefixed with namespace)
+     * @param message The message; subscribers may keep the pointer
+     * @return true if the message was delivered locally or forwarded
+     */
+    bool publish(const std::string &topic, const InProcessBus::MessagePtr &message);
+
+    /**
+     * @brief Publish a message by reference.
+     *
+     * Drop-in replacement for ZyrePublisher::publish().  The message is
+     * copied once into a shared object, and only when a local subscriber
+     * exists.
+     */
+    bool publish(const std::string &topic, const google::protobuf::Message &message);
+
+    /**
+     * @brief Get the namespace name.
+     * @return The namespace string used for topic prefixing
+     */
+    const std::string &name() const { return _name; }
+
+private:
+    std::string _name;                ///< Namespace for topic isolation
+    InProcessBus &_bus;               ///< Bus messages are delivered on
+    ZyrePublisher *_remote = nullptr; ///< Optional forwarder to remote peers
+};
+
+#endif // INPROCESSPUBLISHER_H
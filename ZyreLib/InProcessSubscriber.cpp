@@ -0,0 +1,27 @@
+#include "InProcessSubscriber.h"
+
+InProcessSubscriber::InProcessSubscriber(const std::string &name, InProcessBus &bus) :
+    _name(name),
+    _bus(bus)
+{
+}
+
+InProcessSubscriber::~InProcessSubscriber()
+{
+    std::lock_guard<std::mutex> lock(_subscriptionsMutex);
+    for (int id : _subscriptionIds)
+    {
+        _bus.unsubscribe(id);
+    }
+}
+
+void InProcessSubscriber::subscribe(const std::string &topic, MessageHandler handler)
+{
+    addSubscription(_bus.subscribe(_name + "/" + topic, std::move(handler)));
+}
+
+void InProcessSubscriber::addSubscription(int id)
+{
+    std::lock_guard<std::mutex> lock(_subscriptionsMutex);
+    _subscriptionIds.push_back(id);
+}
@@ -0,0 +1,102 @@
+#ifndef INPROCESSSUBSCRIBER_H
+#define INPROCESSSUBSCRIBER_H
+
+#include "InProcessBus.h"
+
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief Subscriber for publishers hosted in the same process.
+ *
+ * Handlers run synchronously on the publishing thread.  All subscriptions
+ * are removed when the subscriber is destroyed.
+ *
+ * @see InProcessPublisher for the corresponding publisher class
+ */
+class InProcessSubscriber
+{
+public:
+    /**
+     * @brief Callback type for serialized handlers, identical to
+     *        ZyreSubscriber::MessageHandler so handlers can be shared.
+     */
+    using MessageHandler = InProcessBus::BytesHandler;
+
+    /**
+     * @brief Callback type for typed handlers.
+     */
+    template <typename T>
+    using TypedHandler = std::function<void(const std::string &topic, std::shared_ptr<const T> message)>;
+
+    /**
+     * @brief Construct an in-process subscriber.
+     *
+     * @param name Namespace for topic isolation (must match publisher's namespace)
+     * @param bus Bus to subscribe on (default: the process-wide bus)
+     */
+    explicit InProcessSubscriber(const std::string &name,
+                                 InProcessBus &bus = InProcessBus::instance());
+
+    /**
+     * @brief Destructor - removes all subscriptions from the bus.
+     */
+    ~InProcessSubscriber();
+
+    /**
+     * @brief Subscribe with a serialized-bytes handler.
+     */
+    void subscribe(const std::string &topic, MessageHandler handler);
+
+    /**
+     * @brief Subscribe with a typed handler.
+     *
+     * When the publisher's object is a T the handler receives that very
+     * object.  Otherwise (a different generated type or a dynamic message)
+     * it is converted through its serialized form.
+     */
+    template <typename T>
+    void subscribe(const std::string &topic, TypedHandler<T> handler)
+    {
+        static_assert(std::is_base_of<google::protobuf::Message, T>::value,
+                      "T must be a protobuf message");
+
+        auto typed = [handler = std::move(handler)](const std::string &namespacedTopic,
+                                                    const InProcessBus::MessagePtr &message)
+        {
+            if (auto same = std::dynamic_pointer_cast<const T>(message))
+            {
+                handler(namespacedTopic, std::move(same));
+                return;
+            }
+
+            auto converted = std::make_shared<T>();
+            if (converted->ParseFromString(message->SerializeAsString()))
+            {
+                handler(namespacedTopic, std::move(converted));
+            }
+        };
+
+        addSubscription(_bus.subscribe(_name + "/" + topic, InProcessBus::TypedHandler(std::move(typed))));
+    }
+
+    /**
+     * @brief Get the namespace name.
+     * @return The namespace string used for topic filtering
+     */
+    const std::string &name() const { return _name; }
+
+private:
+    void addSubscription(int id);
+
+    std::string _name;                  ///< Namespace for topic filtering
+    InProcessBus &_bus;                 ///< Bus subscriptions live on
+    std::vector<int> _subscriptionIds;  ///< IDs to remove on destruction
+    std::mutex _subscriptionsMutex;     ///< Protects _subscriptionIds
+};
+
+#endif // INPROCESSSUBSCRIBER_H
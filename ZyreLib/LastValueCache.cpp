@@ -0,0 +1,75 @@
+#include "LastValueCache.h"
+
+LastValueCache::LastValueCache(size_t maxBytesPerTopic) :
+    _maxBytesPerTopic(maxBytesPerTopic)
+{
+}
+
+void LastValueCache::store(const std::string &namespacedTopic, const void *data, size_t size)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    if (size > _maxBytesPerTopic)
+    {
+        // Serving an older value would be worse than serving none
+        _values.erase(namespacedTopic);
+        return;
+    }
+
+    // assign() reuses the existing buffer when the topic is already cached
+    _values[namespacedTopic].assign(static_cast<const char*>(data), size);
+}
+
+size_t LastValueCache::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _values.size();
+}
+
+bool LastValueCache::isCommand(zmsg_t *msg, const char *command)
+{
+    zframe_t *frame = msg ? zmsg_first(msg) : nullptr;
+    return frame && zframe_streq(frame, command);
+}
+
+zmsg_t *LastValueCache::buildRequest(const std::vector<std::string> &namespacedTopics)
+{
+    zmsg_t *request = zmsg_new();
+    zmsg_addstr(request, kRequestCommand);
+    for (const auto &topic : namespacedTopics)
+    {
+        zmsg_addstr(request, topic.c_str());
+    }
+    return request;
+}
+
+zmsg_t *LastValueCache::buildReply(zmsg_t *request) const
+{
+    if (!isCommand(request, kRequestCommand))
+    {
+        return nullptr;
+    }
+
+    zmsg_t *reply = zmsg_new();
+    zmsg_addstr(reply, kReplyCommand);
+    bool hasValues = false;
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    for (zframe_t *frame = zmsg_next(request); frame; frame = zmsg_next(request))
+    {
+        std::string topic(reinterpret_cast<const char*>(zframe_data(frame)), zframe_size(frame));
+        auto it = _values.find(topic);
+        if (it != _values.end())
+        {
+            zmsg_addmem(reply, topic.data(), topic.size());
+            zmsg_addmem(reply, it->second.data(), it->second.size());
+            hasValues = true;
+        }
+    }
+
+    if (!hasValues)
+    {
+        zmsg_destroy(&reply);
+    }
+    return reply;
+}
@@ -0,0 +1,72 @@
+#ifndef LASTVALUECACHE_H
+#define LASTVALUECACHE_H
+
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <czmq.h>
+
+/**
+ * @brief Bounded per-topic store of the last serialized value published,
+ *        plus the WHISPER snapshot protocol used to serve it.
+ *
+ * A publisher with a cache advertises the header kHeaderName (value: its
+ * namespace).  Subscribers in the same namespace that see such a peer
+ * ENTER whisper a snapshot request naming their topics and receive the
+ * cached values immediately, instead of waiting for the next publish.
+ *
+ * Request frames: [kRequestCommand][topic]...
+ * Reply frames:   [kReplyCommand][topic][payload]...
+ * Topics are fully namespaced group names.
+ */
+class LastValueCache
+{
+public:
+    static constexpr const char *kHeaderName = "X-ZYRE-LVC";
+    static constexpr const char *kRequestCommand = "LVC_REQUEST";
+    static constexpr const char *kReplyCommand = "LVC_SNAPSHOT";
+
+    /**
+     * @param maxBytesPerTopic Largest value kept per topic; larger values
+     *        evict the topic instead of being cached.
+     */
+    explicit LastValueCache(size_t maxBytesPerTopic);
+
+    /**
+     * @brief Remember the latest serialized value of a topic.
+     */
+    void store(const std::string &namespacedTopic, const void *data, size_t size);
+
+    /**
+     * @brief Number of topics currently cached.
+     */
+    size_t size() const;
+
+    /**
+     * @brief Build the reply to a snapshot request.
+     *
+     * @param request Whisper message; its first frame must be kRequestCommand
+     * @return Reply to whisper back (caller owns it), or nullptr if none of
+     *         the requested topics is cached
+     */
+    zmsg_t *buildReply(zmsg_t *request) const;
+
+    /**
+     * @brief Build a snapshot request for the given namespaced topics.
+     */
+    static zmsg_t *buildRequest(const std::vector<std::string> &namespacedTopics);
+
+    /**
+     * @brief True if the message's first frame is the given command.
+     */
+    static bool isCommand(zmsg_t *msg, const char *command);
+
+private:
+    size_t _maxBytesPerTopic;                            ///< Per-topic memory bound
+    std::unordered_map<std::string, std::string> _values; ///< Topic -> last value
+    mutable std::mutex _mutex;                           ///< Protects _values
+};
+
+#endif // LASTVALUECACHE_H
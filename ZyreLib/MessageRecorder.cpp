@@ -0,0 +1,244 @@
+#include "MessageRecorder.h"
+#include "HighBandwidthSubscriber.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstdio>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <limits>
+#include <sys/mman.h>
+#include <unistd.h>
+
+namespace
+{
+constexpr uint32_t kRecordingMagic = 0x5a524543;  // "ZREC"
+constexpr uint32_t kRecordingVersion = 1;
+constexpr size_t kMaxSegmentSize = 0xFFFFFFFFu;   // offsets are 32 bit
+
+size_t paddedRecordSize(size_t topicLen, size_t payloadLen)
+{
+    return (sizeof(RecordingRecordHeader) + topicLen + payloadLen + 7) & ~size_t(7);
+}
+}
+
+MessageRecorder::MessageRecorder(const std::string &basePath, size_t segmentSize, uint32_t indexInterval) :
+    _basePath(basePath),
+    _segmentSize(std::min(std::max(segmentSize, size_t(4096)), kMaxSegmentSize)),
+    _indexInterval(indexInterval == 0 ? 1 : indexInterval)
+{
+}
+
+MessageRecorder::~MessageRecorder()
+{
+    close();
+}
+
+std::string MessageRecorder::segmentPath(const std::string &basePath, uint32_t segment)
+{
+    char suffix[32];
+    snprintf(suffix, sizeof(suffix), ".%05u.seg", segment);
+    return basePath + suffix;
+}
+
+std::string MessageRecorder::indexPath(const std::string &basePath)
+{
+    return basePath + ".idx";
+}
+
+bool MessageRecorder::open()
+{
+    close();
+
+    std::lock_guard<std::mutex> lock(_mutex);
+    std::string path = indexPath(_basePath);
+    _indexFd = ::open(path.c_str(), O_CREAT | O_TRUNC | O_WRONLY | O_APPEND, 0644);
+    if (_indexFd < 0)
+    {
+        std::cerr << "Failed to create index " << path << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    _recordCount = 0;
+    _lastTimestampNs = std::numeric_limits<int64_t>::min();
+    _openWallNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    _openSteady = std::chrono::steady_clock::now();
+    return openSegment(0);
+}
+
+void MessageRecorder::close()
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    closeSegment();
+    if (_indexFd >= 0)
+    {
+        ::close(_indexFd);
+        _indexFd = -1;
+    }
+}
+
+void MessageRecorder::attach(HighBandwidthSubscriber &subscriber)
+{
+    subscriber.setObserver([this](const std::string &topic, const std::string &payload)
+    {
+        record(topic, payload);
+    });
+}
+
+uint64_t MessageRecorder::recordCount() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _recordCount;
+}
+
+bool MessageRecorder::record(const std::string &topic, const std::string &payload)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    auto elapsed = std::chrono::steady_clock::now() - _openSteady;
+    int64_t timestampNs = _openWallNs + std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    return append(topic, payload.data(), payload.size(), timestampNs);
+}
+
+bool MessageRecorder::record(const std::string &topic, const void *data, size_t size, int64_t timestampNs)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return append(topic, data, size, timestampNs);
+}
+
+bool MessageRecorder::append(const std::string &topic, const void *data, size_t size, int64_t timestampNs)
+{
+    // Caller holds _mutex
+    size_t recordSize = paddedRecordSize(topic.size(), size);
+    if (recordSize > _segmentSize - sizeof(RecordingSegmentHeader) || topic.size() > UINT32_MAX)
+    {
+        std::cerr << "Message of " << size << " bytes does not fit a recording segment" << std::endl;
+        return false;
+    }
+
+    if (!_segment)
+    {
+        return false;
+    }
+
+    timestampNs = std::max(timestampNs, _lastTimestampNs);
+    _lastTimestampNs = timestampNs;
+
+    // Roll over to a fresh segment when this record doesn't fit
+    if (sizeof(RecordingSegmentHeader) + _header->usedBytes + recordSize > _segmentSize)
+    {
+        uint32_t next = _segmentNumber + 1;
+        closeSegment();
+        if (!openSegment(next))
+        {
+            return false;
+        }
+    }
+
+    uint32_t offset = static_cast<uint32_t>(sizeof(RecordingSegmentHeader) + _header->usedBytes);
+    uint8_t *dest = _segment + offset;
+
+    RecordingRecordHeader recordHeader;
+    recordHeader.timestampNs = timestampNs;
+    recordHeader.topicLen = static_cast<uint32_t>(topic.size());
+    recordHeader.payloadLen = static_cast<uint32_t>(size);
+    memcpy(dest, &recordHeader, sizeof(recordHeader));
+    memcpy(dest + sizeof(recordHeader), topic.data(), topic.size());
+    memcpy(dest + sizeof(recordHeader) + topic.size(), data, size);
+
+    if (_header->usedBytes == 0)
+    {
+        _header->firstTimestampNs = timestampNs;
+    }
+    _header->lastTimestampNs = timestampNs;
+    _header->usedBytes += recordSize;
+
+    // The first record of every segment is always indexed so the replayer
+    // learns about every segment from the index alone.
+    if (offset == sizeof(RecordingSegmentHeader) || _sinceIndex >= _indexInterval)
+    {
+        writeIndexEntry(timestampNs, offset);
+        _sinceIndex = 0;
+    }
+    ++_sinceIndex;
+    ++_recordCount;
+    return true;
+}
+
+bool MessageRecorder::openSegment(uint32_t segment)
+{
+    std::string path = segmentPath(_basePath, segment);
+    int fd = ::open(path.c_str(), O_CREAT | O_TRUNC | O_RDWR, 0644);
+    if (fd < 0)
+    {
+        std::cerr << "Failed to create segment " << path << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    if (ftruncate(fd, static_cast<off_t>(_segmentSize)) != 0)
+    {
+        std::cerr << "Failed to size segment " << path << ": " << strerror(errno) << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    void *mapping = mmap(nullptr, _segmentSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        std::cerr << "Failed to map segment " << path << ": " << strerror(errno) << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    _segmentFd = fd;
+    _segment = static_cast<uint8_t*>(mapping);
+    _segmentNumber = segment;
+    _sinceIndex = 0;
+
+    _header = reinterpret_cast<RecordingSegmentHeader*>(_segment);
+    _header->magic = kRecordingMagic;
+    _header->version = kRecordingVersion;
+    _header->usedBytes = 0;
+    _header->firstTimestampNs = 0;
+    _header->lastTimestampNs = 0;
+    return true;
+}
+
+void MessageRecorder::closeSegment()
+{
+    if (!_segment)
+    {
+        return;
+    }
+
+    size_t used = sizeof(RecordingSegmentHeader) + _header->usedBytes;
+    munmap(_segment, _segmentSize);
+
+    // Give back the unused tail of the preallocated segment
+    if (ftruncate(_segmentFd, static_cast<off_t>(used)) != 0)
+    {
+        std::cerr << "Failed to trim segment: " << strerror(errno) << std::endl;
+    }
+    ::close(_segmentFd);
+
+    _segment = nullptr;
+    _header = nullptr;
+    _segmentFd = -1;
+}
+
+bool MessageRecorder::writeIndexEntry(int64_t timestampNs, uint32_t offset)
+{
+    RecordingIndexEntry entry;
+    entry.timestampNs = timestampNs;
+    entry.segment = _segmentNumber;
+    entry.offset = offset;
+
+    if (write(_indexFd, &entry, sizeof(entry)) != static_cast<ssize_t>(sizeof(entry)))
+    {
+        std::cerr << "Failed to write index entry: " << strerror(errno) << std::endl;
+        return false;
+    }
+    return true;
+}
@@ -0,0 +1,154 @@
+#ifndef MESSAGERECORDER_H
+#define MESSAGERECORDER_H
+
+#include <chrono>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+class HighBandwidthSubscriber;
+
+/**
+ * @brief Header at the start of every recording segment file.
+ */
+struct RecordingSegmentHeader
+{
+    uint32_t magic;            ///< kRecordingMagic
+    uint32_t version;          ///< Format version
+    uint64_t usedBytes;        ///< Bytes of records following this header
+    int64_t firstTimestampNs;  ///< Receive time of the first record
+    int64_t lastTimestampNs;   ///< Receive time of the last record
+};
+
+/**
+ * @brief Header in front of every recorded message.
+ *
+ * Followed by topicLen bytes of topic and payloadLen bytes of payload,
+ * padded to an 8-byte boundary.
+ */
+struct RecordingRecordHeader
+{
+    int64_t timestampNs;  ///< Receive time, nanoseconds since the epoch; never decreases
+    uint32_t topicLen;    ///< Length of the namespaced topic
+    uint32_t payloadLen;  ///< Length of the serialized payload
+};
+
+/**
+ * @brief Sparse time index entry pointing at a record.
+ *
+ * One entry is written for the first record of every segment and for
+ * every Nth record after that, so a time window can be located with a
+ * binary search over the (small) index file.
+ */
+struct RecordingIndexEntry
+{
+    int64_t timestampNs;  ///< Timestamp of the referenced record
+    uint32_t segment;     ///< Segment number
+    uint32_t offset;      ///< Byte offset of the record within the segment
+};
+
+/**
+ * @brief Appends completed messages to a segmented, memory-mapped log.
+ *
+ * A recording named "capture" consists of "capture.00000.seg",
+ * "capture.00001.seg", ... and an index "capture.idx".  Each segment is a
+ * fixed-size file mapped into memory; records are copied straight into the
+ * mapping, so recording costs a memcpy and no system call except when a
+ * segment rolls over or an index entry is written.
+ *
+ * @see MessageReplayer to play a recording back
+ */
+class MessageRecorder
+{
+public:
+    /**
+     * @brief Construct a recorder.
+     *
+     * @param basePath Path prefix for the segment and index files
+     * @param segmentSize Size of each segment file in bytes (default: 64 MiB, max 4 GiB)
+     * @param indexInterval Write an index entry every N records (default: 64)
+     */
+    explicit MessageRecorder(const std::string &basePath,
+                             size_t segmentSize = 64 * 1024 * 1024,
+                             uint32_t indexInterval = 64);
+
+    /**
+     * @brief Destructor - closes the recording.
+     */
+    ~MessageRecorder();
+
+    /**
+     * @brief Create the index and first segment, replacing any previous
+     *        recording with the same base path.
+     * @return true if the recording is ready
+     */
+    bool open();
+
+    /**
+     * @brief Flush and close the current segment and the index.
+     */
+    void close();
+
+    /**
+     * @brief Record every message completed by a HighBandwidthSubscriber.
+     *
+     * Installs this recorder as the subscriber's observer.  The recorder
+     * must outlive the subscriber, or be detached with setObserver({}).
+     */
+    void attach(HighBandwidthSubscriber &subscriber);
+
+    /**
+     * @brief Append a message stamped with the current time.
+     *
+     * The time is the wall clock at open() advanced by the steady clock,
+     * so adjustments of the system clock while recording cannot reorder
+     * the log.
+     */
+    bool record(const std::string &topic, const std::string &payload);
+
+    /**
+     * @brief Append a message with an explicit receive timestamp.
+     *
+     * @param topic Full namespaced topic
+     * @param data Serialized payload
+     * @param size Payload size in bytes
+     * @param timestampNs Receive time in nanoseconds since the epoch.
+     *        A time earlier than the previous record's is raised to it:
+     *        the index and replay pacing rely on ordered timestamps.
+     * @return false if the recorder is closed or the record is larger
+     *         than a segment
+     */
+    bool record(const std::string &topic, const void *data, size_t size, int64_t timestampNs);
+
+    /**
+     * @brief Number of messages recorded since open().
+     */
+    uint64_t recordCount() const;
+
+    static std::string segmentPath(const std::string &basePath, uint32_t segment);
+    static std::string indexPath(const std::string &basePath);
+
+private:
+    bool append(const std::string &topic, const void *data, size_t size, int64_t timestampNs);
+    bool openSegment(uint32_t segment);
+    void closeSegment();
+    bool writeIndexEntry(int64_t timestampNs, uint32_t offset);
+
+    std::string _basePath;     ///< Path prefix for all files
+    size_t _segmentSize;       ///< Mapped size of each segment
+    uint32_t _indexInterval;   ///< Records between index entries
+
+    int _indexFd{-1};                        ///< Index file descriptor
+    int _segmentFd{-1};                      ///< Current segment file descriptor
+    uint8_t *_segment{nullptr};              ///< Current segment mapping
+    RecordingSegmentHeader *_header{nullptr}; ///< Header of the current segment
+    uint32_t _segmentNumber{0};              ///< Current segment number
+    uint32_t _sinceIndex{0};                 ///< Records since the last index entry
+    uint64_t _recordCount{0};                ///< Records since open()
+    int64_t _lastTimestampNs{0};             ///< Timestamp of the latest record
+    int64_t _openWallNs{0};                  ///< System clock at open()
+    std::chrono::steady_clock::time_point _openSteady; ///< Steady clock at open()
+    mutable std::mutex _mutex;               ///< Serializes appends
+};
+
+#endif // MESSAGERECORDER_H
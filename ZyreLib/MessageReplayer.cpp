@@ -0,0 +1,198 @@
+#include "MessageReplayer.h"
+#include "HighBandwidthPublisher.h"
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <cstring>
+#include <fcntl.h>
+#include <iostream>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <thread>
+#include <unistd.h>
+
+MessageReplayer::MessageReplayer(const std::string &basePath) :
+    _basePath(basePath)
+{
+}
+
+bool MessageReplayer::open()
+{
+    _index.clear();
+    _lastSegment = 0;
+
+    std::string path = MessageRecorder::indexPath(_basePath);
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        std::cerr << "Failed to open index " << path << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    RecordingIndexEntry entry;
+    while (read(fd, &entry, sizeof(entry)) == static_cast<ssize_t>(sizeof(entry)))
+    {
+        _index.push_back(entry);
+        _lastSegment = std::max(_lastSegment, entry.segment);
+    }
+    ::close(fd);
+
+    return !_index.empty();
+}
+
+int64_t MessageReplayer::firstTimestamp() const
+{
+    return _index.empty() ? 0 : _index.front().timestampNs;
+}
+
+size_t MessageReplayer::seek(int64_t startNs) const
+{
+    // The entry before the first one at or after startNs. Equal timestamps
+    // can span several entries, and the records before the first of them
+    // may share it too, so the scan starts one entry earlier; at most
+    // indexInterval records before startNs are skipped over.
+    auto it = std::lower_bound(_index.begin(), _index.end(), startNs,
+                               [](const RecordingIndexEntry &entry, int64_t ts) { return entry.timestampNs < ts; });
+    return it == _index.begin() ? 0 : static_cast<size_t>(it - _index.begin()) - 1;
+}
+
+bool MessageReplayer::mapSegment(uint32_t segment, SegmentMapping &mapping)
+{
+    std::string path = MessageRecorder::segmentPath(_basePath, segment);
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0)
+    {
+        std::cerr << "Failed to open segment " << path << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(RecordingSegmentHeader))
+    {
+        ::close(fd);
+        return false;
+    }
+
+    size_t size = static_cast<size_t>(st.st_size);
+    void *data = mmap(nullptr, size, PROT_READ, MAP_SHARED, fd, 0);
+    ::close(fd);
+    if (data == MAP_FAILED)
+    {
+        std::cerr << "Failed to map segment " << path << ": " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    // Replay reads front to back
+    madvise(data, size, MADV_SEQUENTIAL);
+
+    mapping.data = static_cast<uint8_t*>(data);
+    mapping.size = size;
+    mapping.number = segment;
+    return true;
+}
+
+void MessageReplayer::unmapSegment(SegmentMapping &mapping)
+{
+    if (mapping.data)
+    {
+        munmap(mapping.data, mapping.size);
+    }
+    mapping = SegmentMapping();
+}
+
+size_t MessageReplayer::replay(const ReplayHandler &handler, double speed, int64_t startNs, int64_t endNs)
+{
+    if (_index.empty())
+    {
+        _stopRequested.store(false);
+        return 0;
+    }
+
+    const RecordingIndexEntry &start = _index[seek(startNs)];
+    SegmentMapping segment;
+    if (!mapSegment(start.segment, segment))
+    {
+        _stopRequested.store(false);
+        return 0;
+    }
+
+    size_t offset = start.offset;
+    size_t replayed = 0;
+    bool paced = speed > 0.0;
+    int64_t firstTimestampNs = 0;
+    auto wallStart = std::chrono::steady_clock::now();
+
+    while (!_stopRequested.load())
+    {
+        const auto *header = reinterpret_cast<const RecordingSegmentHeader*>(segment.data);
+        size_t end = std::min(segment.size, sizeof(RecordingSegmentHeader) + static_cast<size_t>(header->usedBytes));
+
+        if (offset + sizeof(RecordingRecordHeader) > end)
+        {
+            // End of this segment, continue with the next one
+            uint32_t next = segment.number + 1;
+            unmapSegment(segment);
+            if (next > _lastSegment || !mapSegment(next, segment))
+            {
+                break;
+            }
+            offset = sizeof(RecordingSegmentHeader);
+            continue;
+        }
+
+        RecordingRecordHeader record;
+        memcpy(&record, segment.data + offset, sizeof(record));
+        size_t recordSize = (sizeof(record) + record.topicLen + record.payloadLen + 7) & ~size_t(7);
+        if (offset + sizeof(record) + record.topicLen + record.payloadLen > end)
+        {
+            std::cerr << "Truncated record in segment " << segment.number << std::endl;
+            break;
+        }
+
+        if (record.timestampNs > endNs)
+        {
+            break;
+        }
+
+        if (record.timestampNs >= startNs)
+        {
+            if (paced)
+            {
+                if (replayed == 0)
+                {
+                    firstTimestampNs = record.timestampNs;
+                    wallStart = std::chrono::steady_clock::now();
+                }
+                auto delay = std::chrono::nanoseconds(static_cast<int64_t>(
+                    static_cast<double>(record.timestampNs - firstTimestampNs) / speed));
+                std::this_thread::sleep_until(wallStart + delay);
+            }
+
+            const char *topic = reinterpret_cast<const char*>(segment.data + offset + sizeof(record));
+            handler(std::string_view(topic, record.topicLen),
+                    std::string_view(topic + record.topicLen, record.payloadLen),
+                    record.timestampNs);
+            ++replayed;
+        }
+
+        offset += recordSize;
+    }
+
+    unmapSegment(segment);
+
+    // Consumed only now, so a stop() that raced with the start still counts
+    _stopRequested.store(false);
+    return replayed;
+}
+
+size_t MessageReplayer::replay(HighBandwidthPublisher &publisher, double speed, int64_t startNs, int64_t endNs)
+{
+    return replay([&publisher](std::string_view topic, std::string_view payload, int64_t)
+    {
+        // Recorded topics carry the recording subscriber's namespace
+        size_t slash = topic.find('/');
+        std::string bareTopic(slash == std::string_view::npos ? topic : topic.substr(slash + 1));
+        publisher.publishRaw(bareTopic, payload.data(), payload.size());
+    }, speed, startNs, endNs);
+}
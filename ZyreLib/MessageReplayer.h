@@ -0,0 +1,108 @@
+#ifndef MESSAGEREPLAYER_H
+#define MESSAGEREPLAYER_H
+
+#include "MessageRecorder.h"
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <vector>
+
+class HighBandwidthPublisher;
+
+/**
+ * @brief Plays back a recording written by MessageRecorder.
+ *
+ * Playback can follow the original inter-message timing, run at a speed
+ * multiplier, or go as fast as possible.  The sparse index lets playback
+ * start at any point in time without scanning earlier segments.
+ */
+class MessageReplayer
+{
+public:
+    /**
+     * @brief Callback for each replayed message.
+     *
+     * @param topic Full namespaced topic as it was recorded
+     * @param payload Serialized payload, valid for the duration of the call
+     * @param timestampNs Original receive time
+     */
+    using ReplayHandler = std::function<void(std::string_view topic, std::string_view payload, int64_t timestampNs)>;
+
+    /// Speed value that disables pacing entirely
+    static constexpr double kAsFastAsPossible = 0.0;
+
+    /**
+     * @brief Construct a replayer for the recording at @p basePath.
+     */
+    explicit MessageReplayer(const std::string &basePath);
+
+    /**
+     * @brief Load the recording's index.
+     * @return false if the index is missing or empty
+     */
+    bool open();
+
+    /**
+     * @brief Replay messages with first <= timestamp <= last.
+     *
+     * @param handler Invoked for each message, on the calling thread
+     * @param speed 1.0 for original timing, N for N× faster,
+     *              kAsFastAsPossible for no pacing
+     * @param startNs Earliest receive time to replay
+     * @param endNs Latest receive time to replay
+     * @return Number of messages replayed
+     */
+    size_t replay(const ReplayHandler &handler,
+                  double speed = 1.0,
+                  int64_t startNs = std::numeric_limits<int64_t>::min(),
+                  int64_t endNs = std::numeric_limits<int64_t>::max());
+
+    /**
+     * @brief Republish a time window through a HighBandwidthPublisher.
+     *
+     * The recorded namespace is replaced with the publisher's own, so a
+     * capture can be replayed into an isolated namespace.
+     */
+    size_t replay(HighBandwidthPublisher &publisher,
+                  double speed = 1.0,
+                  int64_t startNs = std::numeric_limits<int64_t>::min(),
+                  int64_t endNs = std::numeric_limits<int64_t>::max());
+
+    /**
+     * @brief Ask a running replay() to return early; callable from any thread.
+     *        A stop() made while no replay is running ends the next one
+     *        before its first message.
+     */
+    void stop() { _stopRequested.store(true); }
+
+    /**
+     * @brief Timestamp of the first indexed record, or 0 before open().
+     */
+    int64_t firstTimestamp() const;
+
+private:
+    /**
+     * @brief Read-only mapping of one segment file.
+     */
+    struct SegmentMapping
+    {
+        uint8_t *data{nullptr};
+        size_t size{0};
+        uint32_t number{0};
+    };
+
+    bool mapSegment(uint32_t segment, SegmentMapping &mapping);
+    void unmapSegment(SegmentMapping &mapping);
+    size_t seek(int64_t startNs) const;
+
+    std::string _basePath;                     ///< Path prefix for all files
+    std::vector<RecordingIndexEntry> _index;   ///< Sparse time index
+    uint32_t _lastSegment{0};                  ///< Highest segment number in the index
+    std::atomic<bool> _stopRequested{false};   ///< Set by stop()
+};
+
+#endif // MESSAGEREPLAYER_H
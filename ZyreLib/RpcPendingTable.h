@@ -0,0 +1,130 @@
+#ifndef RPCPENDINGTABLE_H
+#define RPCPENDINGTABLE_H
+
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief In-flight requests of a ZyreRpcNode, keyed by correlation ID and
+ *        ordered by deadline.
+ *
+ * Every request has exactly one deadline entry, removed together with the
+ * request however it completes, so the deadline index never holds more
+ * than the requests actually in flight.  Not thread safe; the node guards
+ * it with its own mutex.
+ *
+ * @tparam Callback Completion callback stored per request.
+ */
+template <typename Callback>
+class RpcPendingTable
+{
+public:
+    using Clock = std::chrono::steady_clock;
+
+    /**
+     * @brief Track a request until take(), expire() or a fail call.
+     */
+    void add(uint64_t id, const std::string &peer, Clock::time_point deadline, Callback callback)
+    {
+        auto position = _deadlines.emplace(deadline, id);
+        _pending[id] = Pending{peer, std::move(callback), position};
+    }
+
+    /**
+     * @brief Remove a request, e.g. when its reply arrives.
+     * @return Its callback, or an empty one if it is no longer pending.
+     */
+    Callback take(uint64_t id)
+    {
+        auto it = _pending.find(id);
+        if (it == _pending.end())
+        {
+            return Callback();
+        }
+        Callback callback = std::move(it->second.callback);
+        _deadlines.erase(it->second.deadline);
+        _pending.erase(it);
+        return callback;
+    }
+
+    /**
+     * @brief Remove every request whose deadline is at or before now.
+     */
+    std::vector<Callback> expire(Clock::time_point now)
+    {
+        std::vector<Callback> expired;
+        while (!_deadlines.empty() && _deadlines.begin()->first <= now)
+        {
+            auto it = _pending.find(_deadlines.begin()->second);
+            expired.push_back(std::move(it->second.callback));
+            _pending.erase(it);
+            _deadlines.erase(_deadlines.begin());
+        }
+        return expired;
+    }
+
+    /**
+     * @brief Remove every request sent to peer.
+     */
+    std::vector<Callback> takePeer(const std::string &peer)
+    {
+        std::vector<Callback> lost;
+        for (auto it = _pending.begin(); it != _pending.end();)
+        {
+            if (it->second.peer == peer)
+            {
+                lost.push_back(std::move(it->second.callback));
+                _deadlines.erase(it->second.deadline);
+                it = _pending.erase(it);
+            }
+            else
+            {
+                ++it;
+            }
+        }
+        return lost;
+    }
+
+    /**
+     * @brief Remove every request.
+     */
+    std::vector<Callback> takeAll()
+    {
+        std::vector<Callback> all;
+        all.reserve(_pending.size());
+        for (auto &entry : _pending)
+        {
+            all.push_back(std::move(entry.second.callback));
+        }
+        _pending.clear();
+        _deadlines.clear();
+        return all;
+    }
+
+    size_t size() const { return _pending.size(); }
+
+    /**
+     * @brief Entries in the deadline index; always equal to size().
+     */
+    size_t deadlineCount() const { return _deadlines.size(); }
+
+private:
+    using Deadlines = std::multimap<Clock::time_point, uint64_t>;
+
+    struct Pending
+    {
+        std::string peer;
+        Callback callback;
+        typename Deadlines::iterator deadline;
+    };
+
+    std::unordered_map<uint64_t, Pending> _pending;
+    Deadlines _deadlines;
+};
+
+#endif // RPCPENDINGTABLE_H
@@ -0,0 +1,42 @@
+#include "SerializedMessage.h"
+
+#include <iostream>
+
+SerializedMessage::SerializedMessage(const google::protobuf::Message &message)
+{
+    auto bytes = std::make_shared<std::string>();
+    if (!message.SerializeToString(bytes.get()))
+    {
+        std::cerr << "Failed to serialize protobuf message" << std::endl;
+        return;
+    }
+    _bytes = std::move(bytes);
+}
+
+#ifdef CZMQ_BUILD_DRAFT_API
+namespace
+{
+// Releases the reference a frame holds on the shared bytes
+void releaseBytes(void **hint)
+{
+    delete static_cast<std::shared_ptr<const std::string>*>(*hint);
+    *hint = nullptr;
+}
+}
+#endif
+
+zframe_t *SerializedMessage::toFrame() const
+{
+    if (!_bytes)
+    {
+        return nullptr;
+    }
+
+#ifdef CZMQ_BUILD_DRAFT_API
+    // The frame owns one more reference; libzmq never writes to the data
+    auto *ref = new std::shared_ptr<const std::string>(_bytes);
+    return zframe_frommem(const_cast<char*>(_bytes->data()), _bytes->size(), releaseBytes, ref);
+#else
+    return zframe_new(_bytes->data(), _bytes->size());
+#endif
+}
@@ -0,0 +1,69 @@
+#ifndef SERIALIZEDMESSAGE_H
+#define SERIALIZEDMESSAGE_H
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <czmq.h>
+#include <google/protobuf/message.h>
+
+/**
+ * @brief A protobuf message serialized once, shared by reference count.
+ *
+ * Publishing the same message to several topics, or to both ZyrePublisher
+ * and HighBandwidthPublisher, normally serializes it once per call.  A
+ * SerializedMessage holds the bytes instead; copies are cheap and every
+ * publish() overload taking one reuses the same buffer.  What is saved is
+ * the serialization: ZyrePublisher still copies the bytes into a frame
+ * (see toFrame()) and Zyre copies that frame again for every peer.
+ *
+ * The bytes are immutable once built, so a SerializedMessage may be shared
+ * freely between threads.
+ *
+ * @code
+ * SerializedMessage serialized(msg);
+ * zyrePub.publish("Telemetry", serialized);
+ * zyrePub.publish("Telemetry/Archive", serialized);
+ * multicastPub.publish("Telemetry", serialized);
+ * @endcode
+ */
+class SerializedMessage
+{
+public:
+    /**
+     * @brief Empty handle; valid() is false.
+     */
+    SerializedMessage() = default;
+
+    /**
+     * @brief Serialize a message.  valid() is false if serialization failed.
+     */
+    explicit SerializedMessage(const google::protobuf::Message &message);
+
+    /**
+     * @brief True if this handle holds serialized bytes.
+     */
+    bool valid() const { return static_cast<bool>(_bytes); }
+
+    const char *data() const { return _bytes ? _bytes->data() : nullptr; }
+    size_t size() const { return _bytes ? _bytes->size() : 0; }
+    std::string_view view() const { return std::string_view(data(), size()); }
+
+    /**
+     * @brief Build a zframe carrying the bytes, for zyre_shout().
+     *
+     * Without CZMQ_BUILD_DRAFT_API, the usual build, the bytes are copied
+     * into the new frame.  With it the frame references this buffer
+     * instead, but Zyre duplicates the frame for each peer when shouting,
+     * so the bytes are copied per peer either way.
+     *
+     * @return New frame owned by the caller, or nullptr if !valid()
+     */
+    zframe_t *toFrame() const;
+
+private:
+    std::shared_ptr<const std::string> _bytes;  ///< Shared serialized payload
+};
+
+#endif // SERIALIZEDMESSAGE_H
@@ -0,0 +1,76 @@
+#include "SharedMemoryPublisher.h"
+
+#include <iostream>
+
+SharedMemoryPublisher::SharedMemoryPublisher(const std::string &name, size_t ringCapacity) :
+    _name(name),
+    _ringCapacity(ringCapacity)
+{
+}
+
+SharedMemoryPublisher::~SharedMemoryPublisher()
+{
+    std::lock_guard<std::mutex> lock(_publishMutex);
+    _rings.clear();
+}
+
+std::string SharedMemoryPublisher::shmNameFor(const std::string &namespacedTopic)
+{
+    // POSIX shm names are a single path component
+    std::string shmName = "/zyre." + namespacedTopic;
+    for (size_t i = 1; i < shmName.size(); ++i)
+    {
+        if (shmName[i] == '/')
+        {
+            shmName[i] = '.';
+        }
+    }
+    return shmName;
+}
+
+SharedMemoryRing *SharedMemoryPublisher::ringFor(const std::string &topic)
+{
+    auto it = _rings.find(topic);
+    if (it != _rings.end())
+    {
+        return it->second.get();
+    }
+
+    auto ring = std::make_unique<SharedMemoryRing>();
+    if (!ring->create(shmNameFor(_name + "/" + topic), _ringCapacity))
+    {
+        return nullptr;
+    }
+
+    return _rings.emplace(topic, std::move(ring)).first->second.get();
+}
+
+bool SharedMemoryPublisher::publish(const std::string &topic, const google::protobuf::Message &message)
+{
+    std::lock_guard<std::mutex> lock(_publishMutex);
+
+    SharedMemoryRing *ring = ringFor(topic);
+    if (!ring)
+    {
+        return false;
+    }
+
+    size_t size = message.ByteSizeLong();
+    uint8_t *buffer = ring->reserve(size);
+    if (!buffer)
+    {
+        std::cerr << "Message of " << size << " bytes does not fit ring for topic: " << topic << std::endl;
+        return false;
+    }
+
+    // Serialize straight into the shared mapping - no intermediate buffer
+    if (!message.SerializeToArray(buffer, static_cast<int>(size)))
+    {
+        std::cerr << "Failed to serialize protobuf message" << std::endl;
+        ring->discard();
+        return false;
+    }
+
+    ring->commit();
+    return true;
+}
@@ -0,0 +1,82 @@
+#ifndef SHAREDMEMORYPUBLISHER_H
+#define SHAREDMEMORYPUBLISHER_H
+
+#include "SharedMemoryRing.h"
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
+#include <google/protobuf/message.h>
+
+/**
+ * @brief Same-host publisher that writes messages into a shared-memory ring
+ *        per topic.
+ *
+ * Each topic gets its own ring in /dev/shm, created on the first publish.
+ * Messages are serialized directly into the ring, so a publish costs one
+ * serialization and no system calls unless a subscriber is asleep.
+ *
+ * @warning Like HighBandwidthPublisher, delivery is **unreliable**: a
+ *          subscriber that falls a whole ring behind loses the overwritten
+ *          messages.  Size the ring for the expected subscriber lag.
+ *
+ * @note There must be a single SharedMemoryPublisher per namespace/topic on a
+ *       host; a second one replaces the first one's ring.
+ *
+ * @see SharedMemorySubscriber for the corresponding subscriber class
+ */
+class SharedMemoryPublisher
+{
+public:
+    /**
+     * @brief Construct a shared-memory publisher.
+     *
+     * @param name Namespace for topic isolation (prefixed to all topics)
+     * @param ringCapacity Size of each topic's ring in bytes (default: 4 MiB)
+     */
+    explicit SharedMemoryPublisher(const std::string &name,
+                                   size_t ringCapacity = 4 * 1024 * 1024);
+
+    /**
+     * @brief Destructor - unlinks every ring this publisher created.
+     */
+    ~SharedMemoryPublisher();
+
+    /**
+     * @brief Publish a protobuf message to the specified topic.
+     *
+     * @param topic The topic name (will be prefixed with namespace)
+     * @param message The protobuf message to publish
+     * @return true if the message was written to the ring
+     * @return false if the ring could not be created or the message is
+     *         larger than half the ring capacity
+     */
+    bool publish(const std::string &topic, const google::protobuf::Message &message);
+
+    /**
+     * @brief Get the namespace name.
+     * @return The namespace string used for topic prefixing
+     */
+    const std::string &name() const { return _name; }
+
+    /**
+     * @brief Shared memory object name used for a namespaced topic.
+     *
+     * Shared with SharedMemorySubscriber so both sides agree on the name.
+     *
+     * @param namespacedTopic "<namespace>/<topic>"
+     */
+    static std::string shmNameFor(const std::string &namespacedTopic);
+
+private:
+    SharedMemoryRing *ringFor(const std::string &topic);
+
+    std::string _name;       ///< Namespace for topic isolation
+    size_t _ringCapacity;    ///< Capacity of newly created rings
+    std::unordered_map<std::string, std::unique_ptr<SharedMemoryRing>> _rings; ///< Topic -> ring
+    std::mutex _publishMutex; ///< Rings are single-writer
+};
+
+#endif // SHAREDMEMORYPUBLISHER_H
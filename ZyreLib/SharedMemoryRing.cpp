@@ -0,0 +1,378 @@
+#include "SharedMemoryRing.h"
+
+#include <cerrno>
+#include <climits>
+#include <cstring>
+#include <ctime>
+#include <fcntl.h>
+#include <iostream>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+namespace
+{
+constexpr uint32_t kShmRingMagic = 0x5a52494e;  // "ZRIN"
+constexpr uint32_t kShmRingVersion = 1;
+constexpr uint32_t kPaddingLength = UINT32_MAX;
+constexpr size_t kRecordAlignment = sizeof(ShmRecordHeader);
+constexpr size_t kHeaderRegion = 4096;  // keeps the data area page aligned
+
+static_assert(std::atomic<uint64_t>::is_always_lock_free, "ring positions must be lock free");
+static_assert(std::atomic<uint32_t>::is_always_lock_free, "futex word must be lock free");
+static_assert(sizeof(ShmRingHeader) <= kHeaderRegion, "ring header must fit the header region");
+static_assert(sizeof(ShmRecordHeader) == 16, "record header must be 16 bytes");
+
+size_t alignRecord(size_t size)
+{
+    return (size + kRecordAlignment - 1) & ~(kRecordAlignment - 1);
+}
+
+size_t roundUpPowerOfTwo(size_t value)
+{
+    size_t result = 4096;
+    while (result < value)
+    {
+        result <<= 1;
+    }
+    return result;
+}
+
+uint32_t *futexWord(std::atomic<uint32_t> &word)
+{
+    return reinterpret_cast<uint32_t*>(&word);
+}
+
+void futexWake(std::atomic<uint32_t> &word)
+{
+    syscall(SYS_futex, futexWord(word), FUTEX_WAKE, INT_MAX, nullptr, nullptr, 0);
+}
+
+void futexWait(std::atomic<uint32_t> &word, uint32_t expected, int timeoutMs)
+{
+    struct timespec timeout;
+    timeout.tv_sec = timeoutMs / 1000;
+    timeout.tv_nsec = static_cast<long>(timeoutMs % 1000) * 1000000L;
+    syscall(SYS_futex, futexWord(word), FUTEX_WAIT, expected, &timeout, nullptr, 0);
+}
+}
+
+SharedMemoryRing::~SharedMemoryRing()
+{
+    close();
+}
+
+bool SharedMemoryRing::create(const std::string &shmName, size_t capacity)
+{
+    close();
+
+    capacity = roundUpPowerOfTwo(capacity);
+
+    // A previous writer may have crashed without unlinking; start fresh so
+    // readers still attached to the old object notice it went stale.
+    shm_unlink(shmName.c_str());
+
+    int fd = shm_open(shmName.c_str(), O_CREAT | O_EXCL | O_RDWR, 0660);
+    if (fd < 0)
+    {
+        std::cerr << "shm_open(" << shmName << ") failed: " << strerror(errno) << std::endl;
+        return false;
+    }
+
+    size_t mappedSize = kHeaderRegion + capacity;
+    if (ftruncate(fd, static_cast<off_t>(mappedSize)) != 0)
+    {
+        std::cerr << "ftruncate(" << shmName << ") failed: " << strerror(errno) << std::endl;
+        ::close(fd);
+        shm_unlink(shmName.c_str());
+        return false;
+    }
+
+    if (!map(fd, mappedSize))
+    {
+        shm_unlink(shmName.c_str());
+        return false;
+    }
+
+    _shmName = shmName;
+    _isWriter = true;
+
+    // ftruncate zero-fills, so the atomics start at zero; publish the magic
+    // last so readers never attach to a half-initialised ring.
+    _header->version = kShmRingVersion;
+    _header->capacity = capacity;
+    _header->reservePos.store(0, std::memory_order_relaxed);
+    _header->commitPos.store(0, std::memory_order_relaxed);
+    _header->wakeSeq.store(0, std::memory_order_relaxed);
+    _header->waiters.store(0, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    _header->magic = kShmRingMagic;
+
+    _data = static_cast<uint8_t*>(_mapping) + kHeaderRegion;
+    _mask = capacity - 1;
+    _pendingEnd = 0;
+    return true;
+}
+
+bool SharedMemoryRing::open(const std::string &shmName)
+{
+    close();
+
+    int fd = shm_open(shmName.c_str(), O_RDWR, 0);
+    if (fd < 0)
+    {
+        return false;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) <= kHeaderRegion)
+    {
+        ::close(fd);
+        return false;
+    }
+
+    if (!map(fd, static_cast<size_t>(st.st_size)))
+    {
+        return false;
+    }
+
+    std::atomic_thread_fence(std::memory_order_acquire);
+    if (_header->magic != kShmRingMagic || _header->version != kShmRingVersion ||
+        kHeaderRegion + _header->capacity != _mappedSize)
+    {
+        close();
+        return false;
+    }
+
+    _shmName = shmName;
+    _isWriter = false;
+    _data = static_cast<uint8_t*>(_mapping) + kHeaderRegion;
+    _mask = _header->capacity - 1;
+    _cursor = _header->commitPos.load(std::memory_order_acquire);
+    _overrunEvents = 0;
+    return true;
+}
+
+bool SharedMemoryRing::map(int fd, size_t mappedSize)
+{
+    void *mapping = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (mapping == MAP_FAILED)
+    {
+        std::cerr << "mmap of shared memory ring failed: " << strerror(errno) << std::endl;
+        ::close(fd);
+        return false;
+    }
+
+    _fd = fd;
+    _mapping = mapping;
+    _mappedSize = mappedSize;
+    _header = static_cast<ShmRingHeader*>(mapping);
+    return true;
+}
+
+void SharedMemoryRing::close()
+{
+    if (_mapping)
+    {
+        munmap(_mapping, _mappedSize);
+    }
+    if (_fd >= 0)
+    {
+        ::close(_fd);
+    }
+    if (_isWriter && !_shmName.empty())
+    {
+        shm_unlink(_shmName.c_str());
+    }
+
+    _fd = -1;
+    _mapping = nullptr;
+    _mappedSize = 0;
+    _header = nullptr;
+    _data = nullptr;
+    _isWriter = false;
+    _shmName.clear();
+}
+
+size_t SharedMemoryRing::maxPayload() const
+{
+    if (!_header) return 0;
+
+    // Keep records well below the capacity so a reader always has at least
+    // half a ring of slack before it is lapped mid-record.
+    return static_cast<size_t>(_header->capacity / 2) - sizeof(ShmRecordHeader);
+}
+
+uint8_t *SharedMemoryRing::reserve(size_t length)
+{
+    if (!_isWriter || length > maxPayload())
+    {
+        return nullptr;
+    }
+
+    uint64_t capacity = _header->capacity;
+    uint64_t pos = _header->commitPos.load(std::memory_order_relaxed);
+    size_t recordSize = alignRecord(sizeof(ShmRecordHeader) + length);
+
+    // Records never straddle the end of the data area: pad to the start.
+    size_t offset = static_cast<size_t>(pos & _mask);
+    size_t padding = 0;
+    if (offset + recordSize > capacity)
+    {
+        padding = static_cast<size_t>(capacity) - offset;
+    }
+
+    // Announce the region we are about to overwrite before touching it so
+    // readers can tell whether the bytes they just consumed were clobbered.
+    _pendingEnd = pos + padding + recordSize;
+    _header->reservePos.store(_pendingEnd, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    if (padding)
+    {
+        auto *pad = reinterpret_cast<ShmRecordHeader*>(_data + offset);
+        pad->position = pos;
+        pad->length = kPaddingLength;
+        pad->recordSize = static_cast<uint32_t>(padding);
+        pos += padding;
+        offset = 0;
+    }
+
+    auto *record = reinterpret_cast<ShmRecordHeader*>(_data + offset);
+    record->position = pos;
+    record->length = static_cast<uint32_t>(length);
+    record->recordSize = static_cast<uint32_t>(recordSize);
+    _pendingRecord = record;
+    return _data + offset + sizeof(ShmRecordHeader);
+}
+
+void SharedMemoryRing::commit()
+{
+    if (!_isWriter || _pendingEnd == 0)
+    {
+        return;
+    }
+
+    _header->commitPos.store(_pendingEnd, std::memory_order_release);
+    _pendingEnd = 0;
+    _pendingRecord = nullptr;
+    _header->wakeSeq.fetch_add(1, std::memory_order_seq_cst);
+    if (_header->waiters.load(std::memory_order_seq_cst) > 0)
+    {
+        futexWake(_header->wakeSeq);
+    }
+}
+
+void SharedMemoryRing::discard()
+{
+    if (!_isWriter || !_pendingRecord)
+    {
+        return;
+    }
+
+    // reservePos cannot move back: readers may already have copied bytes the
+    // aborted write clobbered, and only reservePos tells them so.
+    _pendingRecord->length = kPaddingLength;
+    _header->commitPos.store(_pendingEnd, std::memory_order_release);
+    _pendingEnd = 0;
+    _pendingRecord = nullptr;
+}
+
+size_t SharedMemoryRing::poll(const RecordHandler &handler)
+{
+    if (!_header || _isWriter)
+    {
+        return 0;
+    }
+
+    uint64_t capacity = _header->capacity;
+    uint64_t commitPos = _header->commitPos.load(std::memory_order_acquire);
+    size_t delivered = 0;
+
+    while (_cursor < commitPos)
+    {
+        if (_header->reservePos.load(std::memory_order_acquire) - _cursor > capacity)
+        {
+            // Lapped: everything up to the writer's current position is gone.
+            ++_overrunEvents;
+            _cursor = commitPos;
+            break;
+        }
+
+        const auto *record = reinterpret_cast<const ShmRecordHeader*>(_data + (_cursor & _mask));
+        uint64_t position = record->position;
+        uint32_t length = record->length;
+        uint32_t recordSize = record->recordSize;
+
+        if (position != _cursor || recordSize < sizeof(ShmRecordHeader) || recordSize > capacity)
+        {
+            ++_overrunEvents;
+            _cursor = commitPos;
+            break;
+        }
+
+        if (length != kPaddingLength)
+        {
+            if (length > recordSize - sizeof(ShmRecordHeader))
+            {
+                ++_overrunEvents;
+                _cursor = commitPos;
+                break;
+            }
+            _record.assign(reinterpret_cast<const char*>(record + 1), length);
+
+            // Seqlock-style check: if the writer reserved over this record
+            // while we copied it, the copy is torn and must not be delivered.
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (_header->reservePos.load(std::memory_order_relaxed) - _cursor > capacity)
+            {
+                ++_overrunEvents;
+                _cursor = _header->commitPos.load(std::memory_order_acquire);
+                break;
+            }
+
+            handler(std::string_view(_record.data(), _record.size()));
+            ++delivered;
+        }
+
+        _cursor += recordSize;
+    }
+
+    return delivered;
+}
+
+bool SharedMemoryRing::wait(int timeoutMs)
+{
+    if (!_header)
+    {
+        return false;
+    }
+
+    uint32_t seq = _header->wakeSeq.load(std::memory_order_seq_cst);
+    if (_header->commitPos.load(std::memory_order_acquire) > _cursor)
+    {
+        return true;
+    }
+
+    _header->waiters.fetch_add(1, std::memory_order_seq_cst);
+    if (_header->commitPos.load(std::memory_order_seq_cst) <= _cursor)
+    {
+        futexWait(_header->wakeSeq, seq, timeoutMs);
+    }
+    _header->waiters.fetch_sub(1, std::memory_order_seq_cst);
+
+    return _header->commitPos.load(std::memory_order_acquire) > _cursor;
+}
+
+bool SharedMemoryRing::isStale() const
+{
+    if (_fd < 0)
+    {
+        return true;
+    }
+
+    struct stat st;
+    return fstat(_fd, &st) != 0 || st.st_nlink == 0;
+}
@@ -0,0 +1,171 @@
+#ifndef SHAREDMEMORYRING_H
+#define SHAREDMEMORYRING_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <string_view>
+
+/**
+ * @brief Control block placed at the start of every shared-memory ring.
+ *
+ * Positions are monotonically increasing byte counts; the offset into the
+ * data area is position & (capacity - 1).  Each hot field lives on its own
+ * cache line so readers polling commitPos don't false-share with the writer.
+ */
+struct ShmRingHeader
+{
+    uint32_t magic;                              ///< kShmRingMagic once initialised
+    uint32_t version;                            ///< Layout version
+    uint64_t capacity;                           ///< Data area size in bytes (power of two)
+    alignas(64) std::atomic<uint64_t> reservePos; ///< End of the record currently being written
+    alignas(64) std::atomic<uint64_t> commitPos;  ///< End of the last fully written record
+    alignas(64) std::atomic<uint32_t> wakeSeq;    ///< Futex word, bumped on every commit
+    std::atomic<uint32_t> waiters;               ///< Number of readers blocked in futex wait
+};
+
+/**
+ * @brief Header written in front of every record in the ring data area.
+ */
+struct ShmRecordHeader
+{
+    uint64_t position;    ///< Ring position of this record (detects being lapped)
+    uint32_t length;      ///< Payload length, or kPaddingLength for wrap padding
+    uint32_t recordSize;  ///< Total record size including this header
+};
+
+/**
+ * @brief Single-writer, multi-reader byte ring in a mmap'd POSIX shared memory
+ *        object (/dev/shm).
+ *
+ * The writer never waits for readers.  Each reader keeps its own cursor in
+ * process-local memory, so any number of readers can attach without the
+ * writer knowing about them.  A reader that falls more than one ring
+ * capacity behind is "lapped": it skips forward to the newest data and the
+ * lap is counted as one overrun event, mirroring the lossy semantics of
+ * HighBandwidthPublisher.  Records are copied out and re-checked against
+ * the writer before delivery, so a lapped reader never sees torn data.
+ *
+ * Readers sleep on a futex in the shared header and are only woken by the
+ * writer when at least one of them is actually waiting.
+ *
+ * @note Linux only (shm_open, mmap and futex).
+ */
+class SharedMemoryRing
+{
+public:
+    /**
+     * @brief Callback for each record read from the ring.
+     *
+     * The view points into a reader-local copy of the record, taken and
+     * checked against the writer before the callback runs, and is only
+     * valid for the duration of the callback.
+     */
+    using RecordHandler = std::function<void(std::string_view data)>;
+
+    SharedMemoryRing() = default;
+    ~SharedMemoryRing();
+
+    SharedMemoryRing(const SharedMemoryRing &) = delete;
+    SharedMemoryRing &operator=(const SharedMemoryRing &) = delete;
+
+    /**
+     * @brief Create (or replace) the ring as its writer.
+     * @param shmName POSIX shared memory name, e.g. "/zyre.ns.topic"
+     * @param capacity Data area size in bytes, rounded up to a power of two
+     * @return true if the ring was created and mapped
+     */
+    bool create(const std::string &shmName, size_t capacity);
+
+    /**
+     * @brief Attach to an existing ring as a reader.
+     *
+     * The reader cursor starts at the writer's current position, so only
+     * records committed after this call are delivered.
+     *
+     * @param shmName POSIX shared memory name used by the writer
+     * @return false if the ring does not exist (yet) or is not initialised
+     */
+    bool open(const std::string &shmName);
+
+    /**
+     * @brief Unmap the ring; the writer also unlinks the shared memory name.
+     */
+    void close();
+
+    bool isOpen() const { return _header != nullptr; }
+
+    /**
+     * @brief Largest payload that can be written in a single record.
+     */
+    size_t maxPayload() const;
+
+    /**
+     * @brief Reserve space for a record of @p length payload bytes.
+     *
+     * The returned pointer is valid until commit().  Only one reservation
+     * may be outstanding at a time (single writer).
+     *
+     * @return Pointer to the payload area, or nullptr if length > maxPayload()
+     */
+    uint8_t *reserve(size_t length);
+
+    /**
+     * @brief Publish the record returned by the last reserve() and wake any
+     *        sleeping readers.
+     */
+    void commit();
+
+    /**
+     * @brief Give up the record returned by the last reserve(), e.g. when
+     *        serialization into it failed.  It is published as a skip
+     *        record that readers step over.
+     */
+    void discard();
+
+    /**
+     * @brief Deliver every record committed since the last call.
+     * @return Number of records delivered
+     */
+    size_t poll(const RecordHandler &handler);
+
+    /**
+     * @brief Block until new data is committed or the timeout elapses.
+     * @return true if data is available to poll()
+     */
+    bool wait(int timeoutMs);
+
+    /**
+     * @brief True once the writer has unlinked this ring (e.g. it restarted
+     *        and created a fresh one); readers should close and re-open.
+     */
+    bool isStale() const;
+
+    /**
+     * @brief Number of times this reader was lapped or caught a record
+     *        being overwritten.  One event may skip many records.
+     */
+    uint64_t overrunEvents() const { return _overrunEvents; }
+
+private:
+    bool map(int fd, size_t mappedSize);
+
+    std::string _shmName;
+    int _fd{-1};
+    bool _isWriter{false};
+    void *_mapping{nullptr};
+    size_t _mappedSize{0};
+    ShmRingHeader *_header{nullptr};
+    uint8_t *_data{nullptr};
+    uint64_t _mask{0};
+
+    uint64_t _cursor{0};       ///< Reader position (process local)
+    uint64_t _overrunEvents{0}; ///< Reader overrun event counter
+    uint64_t _pendingEnd{0};   ///< Writer: end position of the outstanding reservation
+    ShmRecordHeader *_pendingRecord{nullptr};  ///< Writer: header of the outstanding reservation
+    std::string _record;       ///< Reader: copy of the record being delivered
+};
+
+#endif // SHAREDMEMORYRING_H
@@ -0,0 +1,126 @@
+#include "SharedMemorySubscriber.h"
+#include "SharedMemoryPublisher.h"  // For shmNameFor()
+#include "SharedMemoryRing.h"
+
+#include <chrono>
+#include <iostream>
+
+namespace
+{
+// How long a reader sleeps before re-checking the stop flag and whether the
+// publisher replaced its ring.
+constexpr int kWaitTimeoutMs = 100;
+}
+
+SharedMemorySubscriber::SharedMemorySubscriber(const std::string &name) :
+    _name(name)
+{
+}
+
+SharedMemorySubscriber::~SharedMemorySubscriber()
+{
+    stop();
+}
+
+void SharedMemorySubscriber::subscribe(const std::string &topic, MessageHandler handler)
+{
+    auto reader = std::make_unique<Reader>();
+    reader->topic = _name + "/" + topic;
+    reader->handler = std::move(handler);
+
+    std::lock_guard<std::mutex> lock(_readersMutex);
+    if (_running.load())
+    {
+        launch(*reader);
+    }
+    _readers.push_back(std::move(reader));
+}
+
+bool SharedMemorySubscriber::start()
+{
+    std::lock_guard<std::mutex> lock(_readersMutex);
+    if (_running.exchange(true))
+    {
+        return true;
+    }
+
+    for (auto &reader : _readers)
+    {
+        launch(*reader);
+    }
+    return true;
+}
+
+void SharedMemorySubscriber::stop()
+{
+    std::lock_guard<std::mutex> lock(_readersMutex);
+    if (!_running.exchange(false))
+    {
+        return;
+    }
+
+    for (auto &reader : _readers)
+    {
+        if (reader->thread.joinable())
+        {
+            reader->thread.join();
+        }
+    }
+}
+
+uint64_t SharedMemorySubscriber::overrunEvents() const
+{
+    std::lock_guard<std::mutex> lock(_readersMutex);
+    uint64_t total = 0;
+    for (const auto &reader : _readers)
+    {
+        total += reader->overrunEvents.load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void SharedMemorySubscriber::launch(Reader &reader)
+{
+    reader.thread = std::thread(&SharedMemorySubscriber::readLoop, this, std::ref(reader));
+}
+
+void SharedMemorySubscriber::readLoop(Reader &reader)
+{
+    const std::string shmName = SharedMemoryPublisher::shmNameFor(reader.topic);
+    SharedMemoryRing ring;
+    uint64_t previousOverrunEvents = 0;
+
+    auto deliver = [&reader](std::string_view data)
+    {
+        reader.handler(reader.topic, data);
+    };
+
+    while (_running.load())
+    {
+        if (!ring.isOpen())
+        {
+            // Publisher hasn't created the ring yet - retry until it does
+            if (!ring.open(shmName))
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(kWaitTimeoutMs));
+                continue;
+            }
+            previousOverrunEvents = 0;
+        }
+
+        if (ring.wait(kWaitTimeoutMs))
+        {
+            ring.poll(deliver);
+
+            uint64_t ringOverrunEvents = ring.overrunEvents();
+            reader.overrunEvents.fetch_add(ringOverrunEvents - previousOverrunEvents,
+                                           std::memory_order_relaxed);
+            previousOverrunEvents = ringOverrunEvents;
+        }
+        else if (ring.isStale())
+        {
+            // Publisher restarted and created a fresh ring under the same name
+            ring.close();
+        }
+    }
+}
@@ -0,0 +1,106 @@
+#ifndef SHAREDMEMORYSUBSCRIBER_H
+#define SHAREDMEMORYSUBSCRIBER_H
+
+#include <atomic>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+/**
+ * @brief Same-host subscriber reading from SharedMemoryPublisher rings.
+ *
+ * Each subscribed topic is served by a reader thread that sleeps on the
+ * ring's futex and hands the handler a view of the message - no socket and
+ * no reassembly.  The view points at a per-reader copy of the record (see
+ * SharedMemoryRing::poll), not at the publisher's buffer, so a lapping
+ * writer can never tear it.  If the publisher has not
+ * created the ring yet (or restarts), the reader keeps retrying in the
+ * background.
+ *
+ * @warning Message delivery is **unreliable**: a subscriber that falls more
+ *          than a ring behind the publisher skips the overwritten messages.
+ *
+ * @see SharedMemoryPublisher for the corresponding publisher class
+ */
+class SharedMemorySubscriber
+{
+public:
+    /**
+     * @brief Callback type for message handlers.
+     *
+     * @param topic The full namespaced topic string
+     * @param data The serialized protobuf, viewed in the reader's private
+     *             copy of the record.  Only valid for the duration of the call.
+     */
+    using MessageHandler = std::function<void(const std::string &topic, std::string_view data)>;
+
+    /**
+     * @brief Construct a shared-memory subscriber.
+     * @param name Namespace for topic isolation (must match publisher's namespace)
+     */
+    explicit SharedMemorySubscriber(const std::string &name);
+
+    /**
+     * @brief Destructor - stops all reader threads.
+     */
+    ~SharedMemorySubscriber();
+
+    /**
+     * @brief Subscribe to a topic with a callback handler.
+     *
+     * May be called before or after start(); subscribing after start()
+     * launches the topic's reader immediately.
+     *
+     * @param topic The topic name to subscribe to (without namespace prefix)
+     * @param handler Callback invoked on the topic's reader thread
+     */
+    void subscribe(const std::string &topic, MessageHandler handler);
+
+    /**
+     * @brief Start a reader thread for every subscribed topic.
+     * @return true once started
+     */
+    bool start();
+
+    /**
+     * @brief Stop and join all reader threads.
+     */
+    void stop();
+
+    /**
+     * @brief Number of overrun events (laps or torn reads) on all topics.
+     *
+     * Each event may skip many messages; the count of lost messages is not
+     * known because records are variable-sized.
+     */
+    uint64_t overrunEvents() const;
+
+    /**
+     * @brief Get the namespace name.
+     * @return The namespace string used for topic filtering
+     */
+    const std::string &name() const { return _name; }
+
+private:
+    struct Reader
+    {
+        std::string topic;                ///< Full namespaced topic
+        MessageHandler handler;           ///< Topic handler
+        std::thread thread;               ///< Reader thread
+        std::atomic<uint64_t> overrunEvents{0}; ///< Overrun events seen by this reader
+    };
+
+    void launch(Reader &reader);
+    void readLoop(Reader &reader);
+
+    std::string _name;                           ///< Namespace for topic filtering
+    std::atomic<bool> _running{false};           ///< Running state flag
+    std::vector<std::unique_ptr<Reader>> _readers; ///< One reader per subscription
+    mutable std::mutex _readersMutex;            ///< Protects _readers
+};
+
+#endif // SHAREDMEMORYSUBSCRIBER_H
@@ -1,11 +1,20 @@
 #include "ZyreNode.h"
+#include "ZyreReactor.h"
+
+#include <cstring>
+#include <iostream>
 
 #include <zyre.h>
 
-ZyreNode::ZyreNode(const std::string &name) : 
+ZyreNode::ZyreNode(const std::string &name, ZyreReactor *reactor, const ZyreNodeConfig &config) : 
     _node(zyre_new(nullptr)),  // Use random UUID for actual node name
-    _nodeName(name)
+    _nodeName(name),
+    _reactor(reactor)
 {
+    if (!configure(config) && _node)
+    {
+        std::cerr << "Failed to configure node " << _nodeName << std::endl;
+    }
 }
 
 ZyreNode::~ZyreNode() 
@@ -21,7 +30,7 @@ ZyreNode::~ZyreNode()
 
 bool ZyreNode::start() 
 {
-    if (!_node) return false;
+    if (!_node || !_configured) return false;
 
     // Reset stop state in case of restart
     {
@@ -34,6 +43,119 @@ bool ZyreNode::start()
     return zyre_start(_node) == 0;
 }
 
+bool ZyreNode::configure(const ZyreNodeConfig &config)
+{
+    _configured = false;
+    if (!_node) return false;
+
+    if (config.beaconIntervalMs > 0)
+    {
+        zyre_set_interval(_node, config.beaconIntervalMs);
+    }
+    if (config.evasiveTimeoutMs > 0)
+    {
+        zyre_set_evasive_timeout(_node, config.evasiveTimeoutMs);
+    }
+    if (config.expiredTimeoutMs > 0)
+    {
+        zyre_set_expired_timeout(_node, config.expiredTimeoutMs);
+    }
+    if (!config.interface.empty())
+    {
+        zyre_set_interface(_node, config.interface.c_str());
+    }
+    if (config.port > 0)
+    {
+        zyre_set_port(_node, config.port);
+    }
+
+    if (!config.endpoint.empty() && zyre_set_endpoint(_node, "%s", config.endpoint.c_str()) != 0)
+    {
+        std::cerr << "Failed to set endpoint " << config.endpoint << std::endl;
+        return false;
+    }
+    if (!config.gossipBind.empty())
+    {
+        zyre_gossip_bind(_node, "%s", config.gossipBind.c_str());
+    }
+    if (!config.gossipConnect.empty())
+    {
+        zyre_gossip_connect(_node, "%s", config.gossipConnect.c_str());
+    }
+    _configured = true;
+    return true;
+}
+
+void ZyreNode::setHeader(const std::string &key, const std::string &value)
+{
+    if (_node)
+    {
+        zyre_set_header(_node, key.c_str(), "%s", value.c_str());
+    }
+}
+
+void ZyreNode::handleEvent(zyre_event_t *)
+{
+}
+
+void ZyreNode::startEvents()
+{
+    if (!_node || _attached || _eventThread.joinable())
+    {
+        return;
+    }
+
+    if (_reactor)
+    {
+        _reactor->add(*this);
+        _attached = true;
+    }
+    else
+    {
+        _eventThread = std::thread(&ZyreNode::eventLoop, this);
+    }
+}
+
+void ZyreNode::stopEvents()
+{
+    // Detach first; the reactor must not read a node that is stopping
+    if (_attached)
+    {
+        _reactor->remove(*this);
+        _attached = false;
+    }
+
+    stop();
+
+    if (_eventThread.joinable())
+    {
+        _eventThread.join();
+    }
+}
+
+void ZyreNode::eventLoop()
+{
+    while (true)
+    {
+        zyre_event_t *event = zyre_event_new(_node);
+        if (!event)
+        {
+            break;
+        }
+
+        // Check for STOP event - indicates zyre_stop() was called
+        const char *type = zyre_event_type(event);
+        if (type && strcmp(type, "STOP") == 0)
+        {
+            zyre_event_destroy(&event);
+            break;
+        }
+
+        handleEvent(event);
+        zyre_event_destroy(&event);
+    }
+}
+
 void ZyreNode::stop() 
 {
     {
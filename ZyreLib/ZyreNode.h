@@ -5,29 +5,87 @@
 #include <condition_variable>
 #include <mutex>
 #include <string>
+#include <thread>
 #include <zyre.h>
 
+class ZyreReactor;
+
+// Discovery tuning. Zero / empty fields keep Zyre's defaults.
+struct ZyreNodeConfig
+{
+    size_t beaconIntervalMs{0};   // UDP beacon period (default 1000)
+    int evasiveTimeoutMs{0};      // Peer considered evasive after (default 5000)
+    int expiredTimeoutMs{0};      // Peer considered gone after (default 30000)
+    std::string interface;        // Network interface for beacons
+    int port{0};                  // UDP beacon port (default 5670)
+
+    // Zyre sizes each peer's outgoing queue itself, at expiredTimeoutMs * 100
+    // messages, and drops a peer that overflows it. Lowering expiredTimeoutMs
+    // is the only per-node bound on that queue.
+
+    // Gossip discovery replaces UDP beacons. It needs our own endpoint
+    // (e.g. "tcp://192.168.1.5:5671") and a gossip hub to bind and/or
+    // connect to.
+    std::string endpoint;
+    std::string gossipBind;
+    std::string gossipConnect;
+};
 
 class ZyreNode {
 public:
-    explicit ZyreNode(const std::string &name);
+    // With a reactor, events are handled on the reactor's thread instead of
+    // a thread per node
+    explicit ZyreNode(const std::string &name, ZyreReactor *reactor = nullptr,
+                      const ZyreNodeConfig &config = ZyreNodeConfig());
     virtual ~ZyreNode();
 
     // start the node; returns true on success
-    bool start();
+    virtual bool start();
     // request stop (calls zyre_stop)
     void stop();
 
     const std::string &name() const { return _nodeName; }
 
+    // Apply discovery settings; must be called before start()
+    // Returns false if the endpoint could not be set; start() then fails
+    // until a later configure() succeeds
+    bool configure(const ZyreNodeConfig &config);
+
+    // Advertise a header to peers; must be called before start()
+    void setHeader(const std::string &key, const std::string &value);
+
 protected:
+    // Handle one event; runs on the node's event thread or on its reactor.
+    // STOP events are consumed before reaching this.
+    virtual void handleEvent(zyre_event_t *event);
+
+    // Begin delivering events to handleEvent()
+    void startEvents();
+    // Stop the node and wait until handleEvent() can no longer be called.
+    // Derived destructors must call this before their members go away.
+    void stopEvents();
+
     zyre_t *_node;
     std::string _nodeName;
 
     // Running flag that derived classes should check
     std::atomic<bool> _isRunning{true};
 
+    // Serializes commands to the zyre actor (shout/whisper/join) issued
+    // from more than one thread
+    std::mutex _sendMutex;
+
 private:
+    friend class ZyreReactor;
+
+    // Blocking per-node event loop, used without a reactor
+    void eventLoop();
+
+    ZyreReactor *_reactor;
+    bool _configured{false};  // Last configure() succeeded
+    bool _attached{false};  // Registered with _reactor
+    std::thread _eventThread;
+
     // Condition variable for cleanup notification
     std::mutex _terminateMutex;
     std::condition_variable _terminateCV;
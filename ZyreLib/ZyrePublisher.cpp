@@ -1,19 +1,204 @@
 #include "ZyrePublisher.h"
 
+#include <cstring>
 #include <iostream>
 
 #include <zyre.h>
 
+struct ZyrePublisher::PendingShout
+{
+    TopicState *state;  // Topics are never erased
+    zmsg_t *zmsg;
+    PendingShout *next;
+};
 
-ZyrePublisher::ZyrePublisher(const std::string &name) :
-    ZyreNode(name)
+ZyrePublisher::ZyrePublisher(const std::string &name, ZyreReactor *reactor, const ZyreNodeConfig &config) :
+    ZyreNode(name, reactor, config)
 {
 }
 
 ZyrePublisher::~ZyrePublisher()
 {
+    _flushTimer.stop();
+    flushAll();
+
+    // Let the sender flush what was already queued while the node is alive
+    if (_sendThread.joinable())
+    {
+        {
+            std::lock_guard<std::mutex> lock(_senderMutex);
+            _senderStop = true;
+        }
+        _senderCV.notify_one();
+        _spaceCV.notify_all();
+        _sendThread.join();
+    }
+
     _isRunning.store(false);
-    stop();
+    stopEvents();
+}
+
+void ZyrePublisher::enableLastValueCache(size_t maxBytesPerTopic)
+{
+    _lastValueCache = std::make_unique<LastValueCache>(maxBytesPerTopic);
+
+    // Tell subscribers in our namespace they can ask us for snapshots
+    setHeader(LastValueCache::kHeaderName, _nodeName);
+}
+
+void ZyrePublisher::enableMultiProducer()
+{
+    _multiProducer = true;
+}
+
+bool ZyrePublisher::setQueueLimit(size_t maxQueuedMessages, OverflowPolicy policy)
+{
+    if (!_multiProducer)
+    {
+        std::cerr << "Queue limit needs multi-producer mode; call enableMultiProducer() first" << std::endl;
+        return false;
+    }
+
+    _queueLimit = maxQueuedMessages;
+    _overflowPolicy = policy;
+    return true;
+}
+
+void ZyrePublisher::enableBatching(size_t maxBatchBytes, unsigned int maxDelayMs)
+{
+    _maxBatchBytes = maxBatchBytes > 0 ? maxBatchBytes : 1;
+    _maxBatchDelayMs = maxDelayMs;
+}
+
+bool ZyrePublisher::start()
+{
+    if (!ZyreNode::start())
+    {
+        return false;
+    }
+
+    // Peer events drive subscriber tracking and snapshot requests
+    startEvents();
+    bool timedFlush = _maxBatchBytes > 0 && _maxBatchDelayMs > 0;
+    if ((_multiProducer || timedFlush) && !_sendThread.joinable())
+    {
+        _sendThread = std::thread(&ZyrePublisher::sendLoop, this);
+    }
+    if (timedFlush)
+    {
+        // The shared timer thread only posts the request: shouting from it
+        // would stall every other timer of the process behind the node
+        _flushTimer.startPeriodic([this]() { requestFlush(); }, _maxBatchDelayMs);
+    }
+    return true;
+}
+
+ZyrePublisher::TopicState &ZyrePublisher::topicState(const std::string &topic)
+{
+    {
+        std::shared_lock<std::shared_mutex> lock(_topicsMutex);
+        auto it = _topics.find(topic);
+        if (it != _topics.end())
+        {
+            return *it->second;
+        }
+    }
+
+    std::unique_lock<std::shared_mutex> lock(_topicsMutex);
+    auto &state = _topics[topic];
+    if (!state)
+    {
+        state = std::make_unique<TopicState>();
+        state->group = _nodeName + "/" + topic;
+
+        auto peers = _groupPeers.find(state->group);
+        state->subscribers.store(peers == _groupPeers.end() ? 0 : peers->second.size());
+    }
+    return *state;
+}
+
+bool ZyrePublisher::hasSubscribers(const std::string &topic)
+{
+    return topicState(topic).subscribers.load(std::memory_order_relaxed) > 0;
+}
+
+void ZyrePublisher::updateMembership(const std::string &group)
+{
+    // Caller holds _topicsMutex exclusively
+    const std::string prefix = _nodeName + "/";
+    if (group.compare(0, prefix.size(), prefix) != 0)
+    {
+        return;
+    }
+
+    auto topic = _topics.find(group.substr(prefix.size()));
+    if (topic != _topics.end())
+    {
+        auto peers = _groupPeers.find(group);
+        topic->second->subscribers.store(peers == _groupPeers.end() ? 0 : peers->second.size());
+    }
+}
+
+ZyrePublisher::Stats ZyrePublisher::stats()
+{
+    Stats result;
+    result.queuedMessages = _queued.load();
+    result.droppedMessages = _dropped.load();
+
+    std::shared_lock<std::shared_mutex> lock(_topicsMutex);
+    for (const auto &topic : _topics)
+    {
+        TopicStats &stats = result.topics[topic.first];
+        stats.messagesSent = topic.second->messagesSent.load(std::memory_order_relaxed);
+        stats.bytesSent = topic.second->bytesSent.load(std::memory_order_relaxed);
+        stats.messagesDropped = topic.second->messagesDropped.load(std::memory_order_relaxed);
+        stats.subscribers = topic.second->subscribers.load(std::memory_order_relaxed);
+    }
+    return result;
+}
+
+zframe_t *ZyrePublisher::serialize(const google::protobuf::Message &message)
+{
+    // Serialize straight into the frame that zyre will send: one
+    // allocation, no intermediate string and no copy into the zmsg
+    size_t size = message.ByteSizeLong();
+    zframe_t *frame = zframe_new(nullptr, size);
+    if (!frame || !message.SerializeToArray(zframe_data(frame), static_cast<int>(size)))
+    {
+        std::cerr << "Failed to serialize protobuf message" << std::endl;
+        if (frame) zframe_destroy(&frame);
+        return nullptr;
+    }
+    return frame;
+}
+
+bool ZyrePublisher::shout(TopicState &state, zmsg_t *zmsg)
+{
+    if (_multiProducer)
+    {
+        return enqueue(state, zmsg);
+    }
+
+    std::lock_guard<std::mutex> lock(_sendMutex);
+    return shoutNow(state, zmsg);
+}
+
+bool ZyrePublisher::shoutNow(TopicState &state, zmsg_t *zmsg)
+{
+    // Caller holds _sendMutex
+    uint64_t messages = zmsg_size(zmsg);
+    uint64_t bytes = zmsg_content_size(zmsg);
+
+    if (zyre_shout(_node, state.group.c_str(), &zmsg) != 0)
+    {
+        std::cerr << "Failed to shout on group: " << state.group << std::endl;
+        if (zmsg) zmsg_destroy(&zmsg);
+        return false;
+    }
+
+    state.messagesSent.fetch_add(messages, std::memory_order_relaxed);
+    state.bytesSent.fetch_add(bytes, std::memory_order_relaxed);
+    return true;
 }
 
 bool ZyrePublisher::publish(const std::string &topic, const google::protobuf::Message &message)
@@ -24,27 +209,331 @@ bool ZyrePublisher::publish(const std::string &topic, const google::protobuf::Me
         return false;
     }
 
-    // Serialize the protobuf message
-    std::string serialized;
-    if (!message.SerializeToString(&serialized)) 
+    TopicState &state = topicState(topic);
+
+    // Nobody listening: skip serialization entirely, unless the value
+    // must be cached for subscribers that join later
+    bool listened = state.subscribers.load(std::memory_order_relaxed) > 0;
+    if (!listened && !_lastValueCache)
     {
-        std::cerr << "Failed to serialize protobuf message" << std::endl;
+        return true;
+    }
+
+    return publishFrame(state, listened, serialize(message));
+}
+
+bool ZyrePublisher::publish(const std::string &topic, const SerializedMessage &message)
+{
+    if (!_node || !_isRunning.load())
+    {
+        std::cerr << "Publisher not running" << std::endl;
         return false;
     }
 
-    // Create namespaced group name
-    std::string namespacedTopic = _nodeName + "/" + topic;
+    TopicState &state = topicState(topic);
+    bool listened = state.subscribers.load(std::memory_order_relaxed) > 0;
+    if (!listened && !_lastValueCache)
+    {
+        return true;
+    }
+
+    return publishFrame(state, listened, message.toFrame());
+}
 
-    // Create zmsg and add the serialized data
+bool ZyrePublisher::publishRaw(const std::string &topic, const void *data, size_t size)
+{
+    if (!_node || !_isRunning.load())
+    {
+        std::cerr << "Publisher not running" << std::endl;
+        return false;
+    }
+
+    TopicState &state = topicState(topic);
+    bool listened = state.subscribers.load(std::memory_order_relaxed) > 0;
+    if (!listened && !_lastValueCache)
+    {
+        return true;
+    }
+
+    return publishFrame(state, listened, zframe_new(data, size));
+}
+
+bool ZyrePublisher::publishFrame(TopicState &state, bool listened, zframe_t *frame)
+{
+    if (!frame)
+    {
+        return false;
+    }
+
+    if (_lastValueCache)
+    {
+        _lastValueCache->store(state.group, zframe_data(frame), zframe_size(frame));
+    }
+    if (!listened)
+    {
+        zframe_destroy(&frame);
+        return true;
+    }
+
+    if (_maxBatchBytes > 0)
+    {
+        // Shout while still holding the batch so batches leave in order;
+        // any wait for queue space happens first, without the lock
+        waitForSpace();
+        std::lock_guard<std::mutex> lock(state.batchMutex);
+        if (!state.batch)
+        {
+            state.batch = zmsg_new();
+        }
+        state.batchBytes += zframe_size(frame);
+        zmsg_append(state.batch, &frame);
+        return state.batchBytes < _maxBatchBytes || flushLocked(state);
+    }
+
+    waitForSpace();
     zmsg_t *zmsg = zmsg_new();
-    zmsg_addmem(zmsg, serialized.data(), serialized.size());
+    zmsg_append(zmsg, &frame);
+    return shout(state, zmsg);
+}
 
-    if (zyre_shout(_node, namespacedTopic.c_str(), &zmsg) != 0) 
+bool ZyrePublisher::publishBatch(const std::string &topic,
+                                 const std::vector<const google::protobuf::Message*> &messages)
+{
+    if (!_node || !_isRunning.load())
     {
-        std::cerr << "Failed to shout on topic: " << topic << std::endl;
-        if (zmsg) zmsg_destroy(&zmsg);
+        std::cerr << "Publisher not running" << std::endl;
         return false;
     }
 
+    TopicState &state = topicState(topic);
+    bool listened = state.subscribers.load(std::memory_order_relaxed) > 0;
+    if (messages.empty() || (!listened && !_lastValueCache))
+    {
+        return true;
+    }
+
+    zmsg_t *zmsg = zmsg_new();
+    for (const auto *message : messages)
+    {
+        zframe_t *frame = serialize(*message);
+        if (!frame)
+        {
+            zmsg_destroy(&zmsg);
+            return false;
+        }
+        zmsg_append(zmsg, &frame);
+    }
+
+    if (_lastValueCache)
+    {
+        zframe_t *last = zmsg_last(zmsg);
+        _lastValueCache->store(state.group, zframe_data(last), zframe_size(last));
+    }
+    if (!listened)
+    {
+        zmsg_destroy(&zmsg);
+        return true;
+    }
+
+    // Anything auto-batched for the topic goes first
+    waitForSpace();
+    std::lock_guard<std::mutex> lock(state.batchMutex);
+    if (state.batch)
+    {
+        flushLocked(state);
+    }
+    return shout(state, zmsg);
+}
+
+bool ZyrePublisher::flushLocked(TopicState &state)
+{
+    // Caller holds state.batchMutex
+    zmsg_t *batch = state.batch;
+    state.batch = nullptr;
+    state.batchBytes = 0;
+    return !batch || shout(state, batch);
+}
+
+void ZyrePublisher::flush(const std::string &topic)
+{
+    TopicState &state = topicState(topic);
+    waitForSpace();
+    std::lock_guard<std::mutex> lock(state.batchMutex);
+    flushLocked(state);
+}
+
+void ZyrePublisher::flushAll()
+{
+    std::shared_lock<std::shared_mutex> topicsLock(_topicsMutex);
+    for (auto &entry : _topics)
+    {
+        std::lock_guard<std::mutex> lock(entry.second->batchMutex);
+        flushLocked(*entry.second);
+    }
+}
+
+void ZyrePublisher::requestFlush()
+{
+    _flushRequested.store(true);
+    std::lock_guard<std::mutex> lock(_senderMutex);
+    _senderCV.notify_one();
+}
+
+void ZyrePublisher::waitForSpace()
+{
+    // Called before any topic's batchMutex is taken: the sender needs those
+    // locks for its timed flush, so waiting while holding one could hang
+    if (!_multiProducer || _queueLimit == 0 || _overflowPolicy != OverflowPolicy::Block ||
+        _queued.load() < _queueLimit)
+    {
+        return;
+    }
+
+    _blockedProducers.fetch_add(1);
+    {
+        std::unique_lock<std::mutex> lock(_senderMutex);
+        _spaceCV.wait(lock, [this] { return _queued.load() < _queueLimit || _senderStop; });
+    }
+    _blockedProducers.fetch_sub(1);
+}
+
+bool ZyrePublisher::enqueue(TopicState &state, zmsg_t *zmsg)
+{
+    // Never waits: Block producers wait in waitForSpace() beforehand, so
+    // the limit may be overshot by one message per concurrent producer
+    if (_queueLimit > 0 && _queued.load() >= _queueLimit && _overflowPolicy == OverflowPolicy::Drop)
+    {
+        uint64_t messages = zmsg_size(zmsg);
+        state.messagesDropped.fetch_add(messages, std::memory_order_relaxed);
+        _dropped.fetch_add(messages, std::memory_order_relaxed);
+        zmsg_destroy(&zmsg);
+        return false;
+    }
+
+    _queued.fetch_add(1);
+    auto *item = new PendingShout{&state, zmsg, _pending.load(std::memory_order_relaxed)};
+    while (!_pending.compare_exchange_weak(item->next, item))
+    {
+    }
+
+    // Only pay for a wakeup when the sender is actually asleep. Both this
+    // load and the sender's store are seq_cst, so either we see it sleeping
+    // or it sees our item before waiting.
+    if (_senderSleeping.load())
+    {
+        std::lock_guard<std::mutex> lock(_senderMutex);
+        _senderCV.notify_one();
+    }
     return true;
-}
\ No newline at end of file
+}
+
+void ZyrePublisher::sendLoop()
+{
+    while (true)
+    {
+        // In multi-producer mode this only queues the batches, behind
+        // whatever was published before them
+        if (_flushRequested.exchange(false))
+        {
+            flushAll();
+        }
+
+        PendingShout *batch = _pending.exchange(nullptr, std::memory_order_acquire);
+        if (!batch)
+        {
+            std::unique_lock<std::mutex> lock(_senderMutex);
+            _senderSleeping.store(true);
+            _senderCV.wait(lock, [this]
+            {
+                return _senderStop || _pending.load() != nullptr || _flushRequested.load();
+            });
+            _senderSleeping.store(false);
+
+            if (_senderStop && _pending.load() == nullptr)
+            {
+                break;
+            }
+            continue;
+        }
+
+        // The stack is newest first; reverse it to keep publish order
+        PendingShout *ordered = nullptr;
+        while (batch)
+        {
+            PendingShout *next = batch->next;
+            batch->next = ordered;
+            ordered = batch;
+            batch = next;
+        }
+
+        // One lock for the whole batch
+        size_t sent = 0;
+        {
+            std::lock_guard<std::mutex> lock(_sendMutex);
+            while (ordered)
+            {
+                PendingShout *item = ordered;
+                ordered = item->next;
+                shoutNow(*item->state, item->zmsg);
+                delete item;
+                ++sent;
+            }
+        }
+
+        _queued.fetch_sub(sent);
+        if (_blockedProducers.load() > 0)
+        {
+            std::lock_guard<std::mutex> lock(_senderMutex);
+            _spaceCV.notify_all();
+        }
+    }
+}
+
+void ZyrePublisher::handleEvent(zyre_event_t *event)
+{
+    const char *type = zyre_event_type(event);
+
+    if (type && (strcmp(type, "JOIN") == 0 || strcmp(type, "LEAVE") == 0))
+    {
+        std::string group = zyre_event_group(event);
+        std::string peer = zyre_event_peer_uuid(event);
+
+        std::unique_lock<std::shared_mutex> lock(_topicsMutex);
+        auto &peers = _groupPeers[group];
+        if (type[0] == 'J')
+        {
+            peers.insert(peer);
+        }
+        else
+        {
+            peers.erase(peer);
+        }
+        updateMembership(group);
+    }
+    else if (type && strcmp(type, "EXIT") == 0)
+    {
+        // A vanished peer leaves every group it was in
+        std::string peer = zyre_event_peer_uuid(event);
+
+        std::unique_lock<std::shared_mutex> lock(_topicsMutex);
+        for (auto &entry : _groupPeers)
+        {
+            if (entry.second.erase(peer))
+            {
+                updateMembership(entry.first);
+            }
+        }
+    }
+    else if (type && strcmp(type, "WHISPER") == 0 && _lastValueCache)
+    {
+        zmsg_t *reply = _lastValueCache->buildReply(zyre_event_msg(event));
+        if (reply)
+        {
+            std::lock_guard<std::mutex> lock(_sendMutex);
+            if (zyre_whisper(_node, zyre_event_peer_uuid(event), &reply) != 0 && reply)
+            {
+                zmsg_destroy(&reply);
+            }
+        }
+    }
+}
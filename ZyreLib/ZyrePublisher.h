@@ -2,19 +2,188 @@
 #define ZYREPUBLISHER_H
 
 #include "ZyreNode.h"
+#include "LastValueCache.h"
+#include "SerializedMessage.h"
+#include "CommonUtils/Timer.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <map>
+#include <memory>
+#include <shared_mutex>
+#include <thread>
+#include <type_traits>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
 
 #include <google/protobuf/message.h>
 
 class ZyrePublisher : public ZyreNode
 {
 public:
-    explicit ZyrePublisher(const std::string &name);
+    // What producers do when the multi-producer queue is full
+    enum class OverflowPolicy
+    {
+        Block,  // Wait for the sender thread to catch up
+        Drop    // Discard the message and count it
+    };
+
+    // Traffic shouted on one topic. Zyre fans each shout out to every peer
+    // in the group internally, so per-peer figures are not observable here.
+    struct TopicStats
+    {
+        uint64_t messagesSent{0};
+        uint64_t bytesSent{0};
+        uint64_t messagesDropped{0};
+        size_t subscribers{0};  // Peers in the topic's group right now
+    };
+
+    struct Stats
+    {
+        size_t queuedMessages{0};    // Waiting for the sender thread
+        uint64_t droppedMessages{0}; // Discarded by OverflowPolicy::Drop
+        std::map<std::string, TopicStats> topics;  // Topic -> stats
+    };
+
+    explicit ZyrePublisher(const std::string &name, ZyreReactor *reactor = nullptr,
+                   const ZyreNodeConfig &config = ZyreNodeConfig());
     ~ZyrePublisher();
 
+    // Keep the last value of every topic (up to maxBytesPerTopic each) and
+    // serve it to late-joining subscribers over WHISPER.
+    // Must be called before start().
+    void enableLastValueCache(size_t maxBytesPerTopic);
+
+    // Cache enabled by enableLastValueCache(), or nullptr
+    LastValueCache *lastValueCache() { return _lastValueCache.get(); }
+
+    // Hand shouts to a dedicated sender thread instead of calling zyre from
+    // the publishing thread. Producers only serialize and push onto a
+    // lock-free queue, so many threads can publish without contending on
+    // the node. Must be called before start().
+    void enableMultiProducer();
+
+    // Bound the multi-producer queue to maxQueuedMessages (approximately,
+    // by up to one message per concurrent producer) so a stalled sender
+    // cannot grow memory without limit. 0 means unbounded (the default).
+    // Only the multi-producer queue can be bounded: returns false, and
+    // changes nothing, unless enableMultiProducer() was called first.
+    bool setQueueLimit(size_t maxQueuedMessages, OverflowPolicy policy);
+
+    // Queue depth, drops and per-topic traffic
+    Stats stats();
+
+    // Coalesce messages per topic: publish() appends to the topic's pending
+    // zmsg, which is shouted once it holds maxBatchBytes or every
+    // maxDelayMs, whichever comes first. Each message stays its own frame.
+    // The timed flush runs on the publisher's sender thread, started for
+    // it if multi-producer mode is off. Must be called before start().
+    void enableBatching(size_t maxBatchBytes, unsigned int maxDelayMs);
+
+    bool start() override;
+
+    // True if at least one peer has joined the topic's group
+    bool hasSubscribers(const std::string &topic);
+
     // Publish a protobuf message to the specified topic
     // Returns true on success, false on failure
+    // Topics nobody subscribes to are skipped before serializing (unless
+    // the last-value cache needs the value)
     bool publish(const std::string &topic,
                  const google::protobuf::Message &message);
+
+    // Publish bytes serialized earlier; the buffer is shared, not re-serialized
+    bool publish(const std::string &topic, const SerializedMessage &message);
+
+    // Publish an already-serialized payload as is, for relays that never
+    // need to parse it
+    bool publishRaw(const std::string &topic, const void *data, size_t size);
+
+    // Publish several messages as the frames of a single shout
+    bool publishBatch(const std::string &topic,
+                      const std::vector<const google::protobuf::Message*> &messages);
+
+    // Shout whatever is pending for a topic (or all topics) right away
+    void flush(const std::string &topic);
+    void flushAll();
+
+    // Lazy overload: builder() returns the message and is only invoked
+    // when someone will receive it, so expensive messages are never built
+    // for topics without subscribers
+    template <typename Builder,
+              typename = std::enable_if_t<std::is_invocable<Builder &>::value>>
+    bool publish(const std::string &topic, Builder &&builder)
+    {
+        if (!_lastValueCache && !hasSubscribers(topic))
+        {
+            return true;
+        }
+        return publish(topic, builder());
+    }
+
+private:
+    // Per-topic state, created on first use and never erased
+    struct TopicState
+    {
+        std::string group;                   // Namespaced group name
+        std::atomic<size_t> subscribers{0};  // Peers currently in the group
+
+        // Running totals for stats()
+        std::atomic<uint64_t> messagesSent{0};
+        std::atomic<uint64_t> bytesSent{0};
+        std::atomic<uint64_t> messagesDropped{0};
+
+        // Auto-batching
+        std::mutex batchMutex;
+        zmsg_t *batch{nullptr};
+        size_t batchBytes{0};
+    };
+
+    // Queued shout, defined in the .cpp
+    struct PendingShout;
+
+    void handleEvent(zyre_event_t *event) override;
+    void sendLoop();
+    void requestFlush();
+    void waitForSpace();
+    bool enqueue(TopicState &state, zmsg_t *zmsg);
+    zframe_t *serialize(const google::protobuf::Message &message);
+    bool shout(TopicState &state, zmsg_t *zmsg);
+    bool shoutNow(TopicState &state, zmsg_t *zmsg);
+    bool publishFrame(TopicState &state, bool listened, zframe_t *frame);
+    bool flushLocked(TopicState &state);
+    void updateMembership(const std::string &group);
+
+    TopicState &topicState(const std::string &topic);
+
+    std::unique_ptr<LastValueCache> _lastValueCache;
+
+    std::unordered_map<std::string, std::unique_ptr<TopicState>> _topics;
+    std::unordered_map<std::string, std::unordered_set<std::string>> _groupPeers;  // From JOIN/LEAVE
+    std::shared_mutex _topicsMutex;  // Protects _topics and _groupPeers
+
+    // Multi-producer mode; the sender thread also runs timed batch flushes
+    bool _multiProducer{false};
+    std::thread _sendThread;
+    std::atomic<PendingShout*> _pending{nullptr};  // LIFO stack pushed by producers
+    std::atomic<bool> _senderSleeping{false};
+    bool _senderStop{false};
+    std::mutex _senderMutex;  // Protects _senderStop, pairs with _senderCV
+    std::condition_variable _senderCV;
+
+    size_t _queueLimit{0};
+    OverflowPolicy _overflowPolicy{OverflowPolicy::Block};
+    std::atomic<size_t> _queued{0};
+    std::atomic<uint64_t> _dropped{0};
+    std::atomic<int> _blockedProducers{0};
+    std::condition_variable _spaceCV;  // Signalled by the sender, with _senderMutex
+
+    // Auto-batching
+    size_t _maxBatchBytes{0};  // 0 when batching is off
+    unsigned int _maxBatchDelayMs{0};
+    CommonUtils::Timer _flushTimer;  // Posts flush requests to the sender
+    std::atomic<bool> _flushRequested{false};
 };
 
 #endif // ZYREPUBLISHER_H
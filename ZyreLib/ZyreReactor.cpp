@@ -0,0 +1,151 @@
+#include "ZyreReactor.h"
+#include "ZyreNode.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include <czmq.h>
+#include <zyre.h>
+
+namespace
+{
+// Upper bound on how long a queued add/remove waits for the poller
+constexpr int kPollIntervalMs = 50;
+}
+
+ZyreReactor::ZyreReactor()
+{
+    _thread = std::thread(&ZyreReactor::run, this);
+}
+
+ZyreReactor::~ZyreReactor()
+{
+    _running.store(false);
+    if (_thread.joinable())
+    {
+        _thread.join();
+    }
+}
+
+size_t ZyreReactor::size() const
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _attached.size();
+}
+
+void ZyreReactor::add(ZyreNode &node)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+    _toAdd.push_back(&node);
+}
+
+void ZyreReactor::remove(ZyreNode &node)
+{
+    std::unique_lock<std::mutex> lock(_mutex);
+
+    // Not picked up yet: just forget it
+    auto pending = std::find(_toAdd.begin(), _toAdd.end(), &node);
+    if (pending != _toAdd.end())
+    {
+        _toAdd.erase(pending);
+        return;
+    }
+
+    if (std::this_thread::get_id() == _thread.get_id())
+    {
+        // From a handler: the poller is not in use right now
+        _toRemove.push_back(&node);
+        return;
+    }
+
+    _toRemove.push_back(&node);
+    _changedCV.wait(lock, [this, &node] { return !_attached.count(&node) || !_running.load(); });
+}
+
+void ZyreReactor::applyChanges(void *poller)
+{
+    std::lock_guard<std::mutex> lock(_mutex);
+
+    // A node removed from one of its own handlers may already be gone, so
+    // only the remembered socket is used here
+    for (ZyreNode *node : _toRemove)
+    {
+        auto it = _attached.find(node);
+        if (it != _attached.end())
+        {
+            zpoller_remove(static_cast<zpoller_t*>(poller), it->second);
+            _nodes.erase(it->second);
+            _attached.erase(it);
+        }
+    }
+
+    for (ZyreNode *node : _toAdd)
+    {
+        void *socket = zyre_socket(node->_node);
+        if (zpoller_add(static_cast<zpoller_t*>(poller), socket) == 0)
+        {
+            _nodes[socket] = node;
+            _attached[node] = socket;
+        }
+        else
+        {
+            std::cerr << "Failed to poll node " << node->name() << std::endl;
+        }
+    }
+
+    bool removed = !_toRemove.empty();
+    _toAdd.clear();
+    _toRemove.clear();
+    if (removed)
+    {
+        _changedCV.notify_all();
+    }
+}
+
+void ZyreReactor::run()
+{
+    zpoller_t *poller = zpoller_new(nullptr);
+
+    while (_running.load())
+    {
+        applyChanges(poller);
+
+        void *socket = zpoller_wait(poller, kPollIntervalMs);
+        if (!socket)
+        {
+            if (zpoller_terminated(poller))
+            {
+                break;
+            }
+            continue;
+        }
+
+        auto it = _nodes.find(socket);
+        if (it == _nodes.end())
+        {
+            continue;
+        }
+
+        // The socket is readable, so this does not block
+        zyre_event_t *event = zyre_event_new(it->second->_node);
+        if (!event)
+        {
+            continue;
+        }
+
+        const char *type = zyre_event_type(event);
+        if (!type || strcmp(type, "STOP") != 0)
+        {
+            it->second->handleEvent(event);
+        }
+        zyre_event_destroy(&event);
+    }
+
+    zpoller_destroy(&poller);
+
+    // Release anyone waiting in remove()
+    std::lock_guard<std::mutex> lock(_mutex);
+    _attached.clear();
+    _changedCV.notify_all();
+}
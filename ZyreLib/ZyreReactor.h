@@ -0,0 +1,58 @@
+#ifndef ZYRELIB_ZYREREACTOR_H
+#define ZYRELIB_ZYREREACTOR_H
+
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+class ZyreNode;
+
+// Handles the events of many Zyre nodes on a single thread by polling their
+// zyre_socket()s, instead of one blocking event thread per node.
+//
+// Pass a reactor to the ZyrePublisher / ZyreSubscriber constructor to use
+// it; nodes constructed without one keep their own event thread. All
+// handlers of attached nodes run on the reactor thread, so they should be
+// quick. For more parallelism, spread nodes over a few reactors.
+// Nodes must be destroyed before the reactor they are attached to.
+class ZyreReactor
+{
+public:
+    ZyreReactor();
+    ~ZyreReactor();
+
+    ZyreReactor(const ZyreReactor &) = delete;
+    ZyreReactor &operator=(const ZyreReactor &) = delete;
+
+    // Number of nodes currently polled
+    size_t size() const;
+
+private:
+    friend class ZyreNode;
+
+    // Called by ZyreNode::startEvents() / stopEvents(). remove() returns
+    // once the reactor will no longer touch the node.
+    void add(ZyreNode &node);
+    void remove(ZyreNode &node);
+
+    void run();
+    void applyChanges(void *poller);
+
+    std::thread _thread;
+    std::atomic<bool> _running{true};
+
+    // Poller changes are queued and applied by the reactor thread, which
+    // owns the zpoller
+    std::vector<ZyreNode*> _toAdd;
+    std::vector<ZyreNode*> _toRemove;
+    std::unordered_map<ZyreNode*, void*> _attached;  // Node -> polled socket
+    mutable std::mutex _mutex;  // Protects the three above
+    std::condition_variable _changedCV;
+
+    std::unordered_map<void*, ZyreNode*> _nodes;  // Socket -> node, reactor thread only
+};
+
+#endif //ZYRELIB_ZYREREACTOR_H
@@ -0,0 +1,260 @@
+#include "ZyreRpcNode.h"
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+#include <zyre.h>
+
+namespace
+{
+constexpr const char *kRequestCommand = "RPC_REQ";
+constexpr const char *kReplyCommand = "RPC_REP";
+
+// Granularity of request timeouts
+constexpr unsigned int kTimeoutSweepMs = 10;
+
+bool frameIs(zframe_t *frame, const char *command)
+{
+    return frame && zframe_streq(frame, command);
+}
+
+std::string_view frameView(zframe_t *frame)
+{
+    return std::string_view(reinterpret_cast<const char*>(zframe_data(frame)), zframe_size(frame));
+}
+}
+
+ZyreRpcNode::ZyreRpcNode(const std::string &name, ZyreReactor *reactor, const ZyreNodeConfig &config) :
+    ZyreNode(name, reactor, config)
+{
+}
+
+ZyreRpcNode::~ZyreRpcNode()
+{
+    _timeoutTimer.stop();
+    stopEvents();
+    failAll(RpcStatus::Stopped);
+}
+
+void ZyreRpcNode::registerMethod(const std::string &method, RawMethod handler)
+{
+    _methods[method] = std::move(handler);
+}
+
+bool ZyreRpcNode::start()
+{
+    // Let clients in our namespace find us
+    if (!_methods.empty())
+    {
+        setHeader(kHeaderName, _nodeName);
+    }
+
+    if (!ZyreNode::start())
+    {
+        return false;
+    }
+
+    startEvents();
+    _timeoutTimer.startPeriodic([this]() { expireRequests(); }, kTimeoutSweepMs);
+    return true;
+}
+
+std::vector<std::string> ZyreRpcNode::servers() const
+{
+    std::lock_guard<std::mutex> lock(_pendingMutex);
+    return _servers;
+}
+
+size_t ZyreRpcNode::inFlight() const
+{
+    std::lock_guard<std::mutex> lock(_pendingMutex);
+    return _pending.size();
+}
+
+void ZyreRpcNode::call(const std::string &peer, const std::string &method,
+                       const void *data, size_t size, unsigned int timeoutMs, RpcCallback callback)
+{
+    uint64_t id = _nextId.fetch_add(1, std::memory_order_relaxed);
+
+    zmsg_t *request = zmsg_new();
+    zmsg_addstr(request, kRequestCommand);
+    zmsg_addmem(request, &id, sizeof(id));
+    zmsg_addstr(request, method.c_str());
+    zmsg_addmem(request, data, size);
+
+    // Register before sending: the reply may arrive before zyre_whisper returns
+    {
+        std::lock_guard<std::mutex> lock(_pendingMutex);
+        _pending.add(id, peer, Clock::now() + std::chrono::milliseconds(timeoutMs), std::move(callback));
+    }
+
+    int rc;
+    {
+        std::lock_guard<std::mutex> lock(_sendMutex);
+        rc = zyre_whisper(_node, peer.c_str(), &request);
+    }
+
+    if (rc != 0)
+    {
+        if (request) zmsg_destroy(&request);
+        RpcCallback failed = takePending(id);
+        if (failed)
+        {
+            failed(RpcReply{RpcStatus::SendFailed, std::string()});
+        }
+    }
+}
+
+std::future<RpcReply> ZyreRpcNode::call(const std::string &peer, const std::string &method,
+                                        std::string_view payload, unsigned int timeoutMs)
+{
+    auto promise = std::make_shared<std::promise<RpcReply>>();
+    auto future = promise->get_future();
+    call(peer, method, payload.data(), payload.size(), timeoutMs, [promise](const RpcReply &reply)
+    {
+        promise->set_value(reply);
+    });
+    return future;
+}
+
+ZyreRpcNode::RpcCallback ZyreRpcNode::takePending(uint64_t id)
+{
+    std::lock_guard<std::mutex> lock(_pendingMutex);
+    return _pending.take(id);
+}
+
+void ZyreRpcNode::handleEvent(zyre_event_t *event)
+{
+    const char *type = zyre_event_type(event);
+    if (!type)
+    {
+        return;
+    }
+
+    if (strcmp(type, "WHISPER") == 0)
+    {
+        zmsg_t *msg = zyre_event_msg(event);
+        zframe_t *command = msg ? zmsg_first(msg) : nullptr;
+        if (frameIs(command, kRequestCommand))
+        {
+            handleRequest(zyre_event_peer_uuid(event), msg);
+        }
+        else if (frameIs(command, kReplyCommand))
+        {
+            handleReply(msg);
+        }
+    }
+    else if (strcmp(type, "ENTER") == 0)
+    {
+        const char *serverNamespace = zyre_event_header(event, kHeaderName);
+        if (serverNamespace && _nodeName == serverNamespace)
+        {
+            std::lock_guard<std::mutex> lock(_pendingMutex);
+            _servers.push_back(zyre_event_peer_uuid(event));
+        }
+    }
+    else if (strcmp(type, "EXIT") == 0)
+    {
+        failPeer(zyre_event_peer_uuid(event));
+    }
+}
+
+void ZyreRpcNode::handleRequest(const char *peer, zmsg_t *request)
+{
+    // Cursor is on the command frame
+    zframe_t *idFrame = zmsg_next(request);
+    zframe_t *methodFrame = zmsg_next(request);
+    zframe_t *payloadFrame = zmsg_next(request);
+    if (!idFrame || !methodFrame || !payloadFrame)
+    {
+        return;
+    }
+
+    std::string response;
+    RpcStatus status = RpcStatus::NoSuchMethod;
+    auto method = _methods.find(std::string(frameView(methodFrame)));
+    if (method != _methods.end())
+    {
+        status = method->second(frameView(payloadFrame), response) ? RpcStatus::Ok : RpcStatus::HandlerFailed;
+    }
+
+    uint8_t statusByte = static_cast<uint8_t>(status);
+    zmsg_t *reply = zmsg_new();
+    zmsg_addstr(reply, kReplyCommand);
+    zmsg_addmem(reply, zframe_data(idFrame), zframe_size(idFrame));
+    zmsg_addmem(reply, &statusByte, sizeof(statusByte));
+    zmsg_addmem(reply, response.data(), response.size());
+
+    std::lock_guard<std::mutex> lock(_sendMutex);
+    if (zyre_whisper(_node, peer, &reply) != 0 && reply)
+    {
+        zmsg_destroy(&reply);
+    }
+}
+
+void ZyreRpcNode::handleReply(zmsg_t *reply)
+{
+    zframe_t *idFrame = zmsg_next(reply);
+    zframe_t *statusFrame = zmsg_next(reply);
+    zframe_t *payloadFrame = zmsg_next(reply);
+    if (!idFrame || zframe_size(idFrame) != sizeof(uint64_t) ||
+        !statusFrame || zframe_size(statusFrame) != 1 || !payloadFrame)
+    {
+        return;
+    }
+
+    uint64_t id;
+    memcpy(&id, zframe_data(idFrame), sizeof(id));
+
+    // Late replies to requests that already timed out are dropped here
+    RpcCallback callback = takePending(id);
+    if (callback)
+    {
+        callback(RpcReply{rpcStatusFromWire(zframe_data(statusFrame)[0]),
+                          std::string(frameView(payloadFrame))});
+    }
+}
+
+void ZyreRpcNode::expireRequests()
+{
+    std::vector<RpcCallback> expired;
+    {
+        std::lock_guard<std::mutex> lock(_pendingMutex);
+        expired = _pending.expire(Clock::now());
+    }
+
+    for (auto &callback : expired)
+    {
+        callback(RpcReply{RpcStatus::Timeout, std::string()});
+    }
+}
+
+void ZyreRpcNode::failPeer(const std::string &peer)
+{
+    std::vector<RpcCallback> lost;
+    {
+        std::lock_guard<std::mutex> lock(_pendingMutex);
+        _servers.erase(std::remove(_servers.begin(), _servers.end(), peer), _servers.end());
+        lost = _pending.takePeer(peer);
+    }
+
+    for (auto &callback : lost)
+    {
+        callback(RpcReply{RpcStatus::PeerLost, std::string()});
+    }
+}
+
+void ZyreRpcNode::failAll(RpcStatus status)
+{
+    std::vector<RpcCallback> pending;
+    {
+        std::lock_guard<std::mutex> lock(_pendingMutex);
+        pending = _pending.takeAll();
+    }
+
+    for (auto &callback : pending)
+    {
+        callback(RpcReply{status, std::string()});
+    }
+}
@@ -0,0 +1,160 @@
+#ifndef ZYRERPCNODE_H
+#define ZYRERPCNODE_H
+
+#include "ZyreNode.h"
+#include "RpcPendingTable.h"
+#include "CommonUtils/Timer.h"
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include <google/protobuf/message.h>
+
+enum class RpcStatus
+{
+    Ok,
+    Timeout,        // No reply before the deadline
+    NoSuchMethod,   // Server has no handler for the method
+    HandlerFailed,  // Server handler returned false
+    BadResponse,    // Reply could not be parsed as the expected type
+    SendFailed,     // Request could not be whispered
+    PeerLost,       // Server left before replying
+    Stopped         // Node shut down with the request in flight
+};
+
+// Status byte of a reply as received; out-of-range values are BadResponse
+inline RpcStatus rpcStatusFromWire(uint8_t status)
+{
+    return status <= static_cast<uint8_t>(RpcStatus::Stopped) ? static_cast<RpcStatus>(status)
+                                                             : RpcStatus::BadResponse;
+}
+
+struct RpcReply
+{
+    RpcStatus status;
+    std::string payload;
+};
+
+template <typename Response>
+struct TypedRpcReply
+{
+    RpcStatus status;
+    Response response;
+};
+
+// Request/reply over WHISPER: requests go to one peer only, carry a
+// correlation ID and may be pipelined freely; replies complete a callback
+// or a future. Every node can both serve methods and call them.
+//
+// Request frames: [RPC_REQ][correlation id][method][payload]
+// Reply frames:   [RPC_REP][correlation id][status][payload]
+class ZyreRpcNode : public ZyreNode
+{
+public:
+    // Server handler: fill response and return true, or return false to fail
+    using RawMethod = std::function<bool(std::string_view request, std::string &response)>;
+    using RpcCallback = std::function<void(const RpcReply &reply)>;
+
+    // Peers advertising methods in our namespace carry this header
+    static constexpr const char *kHeaderName = "X-ZYRE-RPC";
+
+    explicit ZyreRpcNode(const std::string &name, ZyreReactor *reactor = nullptr,
+                         const ZyreNodeConfig &config = ZyreNodeConfig());
+    ~ZyreRpcNode();
+
+    // Serve a method; must be called before start()
+    void registerMethod(const std::string &method, RawMethod handler);
+
+    // Typed server handler
+    template <typename Request, typename Response>
+    void registerMethod(const std::string &method, std::function<bool(const Request &, Response &)> handler)
+    {
+        registerMethod(method, [handler](std::string_view data, std::string &out)
+        {
+            Request request;
+            Response response;
+            if (!request.ParseFromArray(data.data(), static_cast<int>(data.size())) || !handler(request, response))
+            {
+                return false;
+            }
+            return response.SerializeToString(&out);
+        });
+    }
+
+    bool start() override;
+
+    // Peers in our namespace that serve methods
+    std::vector<std::string> servers() const;
+
+    // Call a method on a peer. The callback runs exactly once, on the event
+    // thread for replies or on the timeout thread otherwise.
+    void call(const std::string &peer, const std::string &method,
+              const void *data, size_t size, unsigned int timeoutMs, RpcCallback callback);
+
+    std::future<RpcReply> call(const std::string &peer, const std::string &method,
+                               std::string_view payload, unsigned int timeoutMs);
+
+    // Typed call: serializes the request and parses the reply as Response
+    template <typename Response>
+    std::future<TypedRpcReply<Response>> call(const std::string &peer, const std::string &method,
+                                              const google::protobuf::Message &request, unsigned int timeoutMs)
+    {
+        auto promise = std::make_shared<std::promise<TypedRpcReply<Response>>>();
+        auto future = promise->get_future();
+
+        std::string data;
+        if (!request.SerializeToString(&data))
+        {
+            promise->set_value(TypedRpcReply<Response>{RpcStatus::SendFailed, Response()});
+            return future;
+        }
+
+        call(peer, method, data.data(), data.size(), timeoutMs, [promise](const RpcReply &reply)
+        {
+            TypedRpcReply<Response> typed{reply.status, Response()};
+            if (typed.status == RpcStatus::Ok &&
+                !typed.response.ParseFromString(reply.payload))
+            {
+                typed.status = RpcStatus::BadResponse;
+            }
+            promise->set_value(std::move(typed));
+        });
+        return future;
+    }
+
+    // Requests waiting for a reply
+    size_t inFlight() const;
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    void handleEvent(zyre_event_t *event) override;
+    void handleRequest(const char *peer, zmsg_t *request);
+    void handleReply(zmsg_t *reply);
+    void expireRequests();
+    void failPeer(const std::string &peer);
+    void failAll(RpcStatus status);
+
+    // Remove and return a pending request, if it is still pending
+    RpcCallback takePending(uint64_t id);
+
+    std::unordered_map<std::string, RawMethod> _methods;  // Fixed after start()
+
+    std::atomic<uint64_t> _nextId{1};
+    RpcPendingTable<RpcCallback> _pending;
+    std::vector<std::string> _servers;
+    mutable std::mutex _pendingMutex;  // Protects _pending and _servers
+
+    CommonUtils::Timer _timeoutTimer;  // One sweep for all in-flight requests
+};
+
+#endif // ZYRERPCNODE_H
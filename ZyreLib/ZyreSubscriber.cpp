@@ -1,10 +1,11 @@
 #include "ZyreSubscriber.h"
+#include "LastValueCache.h"
 
 #include <cstring>
 #include <iostream>
 
-ZyreSubscriber::ZyreSubscriber(const std::string &name) :
-    ZyreNode(name)
+ZyreSubscriber::ZyreSubscriber(const std::string &name, ZyreReactor *reactor, const ZyreNodeConfig &config) :
+    ZyreNode(name, reactor, config)
 {
     if (!start()) 
     {
@@ -12,17 +13,13 @@ ZyreSubscriber::ZyreSubscriber(const std::string &name) :
         return;
     }
 
-    // Spawn background thread to handle incoming messages
-    _receiveThread = std::thread(&ZyreSubscriber::receiveLoop, this);
+    // Handle incoming messages on our own thread or the reactor's
+    startEvents();
 }
 
 ZyreSubscriber::~ZyreSubscriber() 
 {
-    stop();
-    if (_receiveThread.joinable())
-    {
-        _receiveThread.join();
-    }
+    stopEvents();
 }
 
 void ZyreSubscriber::subscribe(const std::string &topic, MessageHandler handler)
@@ -30,69 +27,224 @@ void ZyreSubscriber::subscribe(const std::string &topic, MessageHandler handler)
     // Create namespaced group name
     std::string namespacedTopic = _nodeName + "/" + topic;
 
+    auto entry = std::make_shared<HandlerEntry>();
+    entry->handler = std::move(handler);
+    addHandler(namespacedTopic, std::move(entry));
+    join(namespacedTopic);
+}
+
+void ZyreSubscriber::subscribeView(const std::string &topic, MessageViewHandler handler)
+{
+    // Create namespaced group name
+    std::string namespacedTopic = _nodeName + "/" + topic;
+
+    auto entry = std::make_shared<HandlerEntry>();
+    entry->viewHandler = std::move(handler);
+    addHandler(namespacedTopic, std::move(entry));
+    join(namespacedTopic);
+}
+
+void ZyreSubscriber::subscribeSnapshots(const std::string &topic, MessageHandler handler)
+{
+    auto entry = std::make_shared<HandlerEntry>();
+    entry->handler = std::move(handler);
+    addHandler(_nodeName + "/" + topic, std::move(entry));
+}
+
+void ZyreSubscriber::watchPeerHeader(const std::string &header, PeerHeaderHandler handler)
+{
     {
         std::lock_guard<std::mutex> lock(_handlersMutex);
-        _handlers[namespacedTopic] = std::move(handler);
+        _peerHeaderHandlers[header] = handler;
+    }
+
+    if (!_node)
+    {
+        return;
     }
 
+    // The node is already running, so peers that entered before the handler
+    // was registered won't ENTER again - replay them from zyre's peer table
+    std::vector<std::pair<std::string, std::string>> known;
+    {
+        std::lock_guard<std::mutex> lock(_sendMutex);
+        zlist_t *peers = zyre_peers(_node);
+        for (auto *peer = peers ? static_cast<const char*>(zlist_first(peers)) : nullptr; peer;
+             peer = static_cast<const char*>(zlist_next(peers)))
+        {
+            char *value = zyre_peer_header_value(_node, peer, header.c_str());
+            if (value)
+            {
+                known.emplace_back(peer, value);
+                zstr_free(&value);
+            }
+        }
+        zlist_destroy(&peers);
+    }
+
+    for (const auto &entry : known)
+    {
+        handler(entry.first, entry.second);
+    }
+}
+
+void ZyreSubscriber::join(const std::string &namespacedTopic)
+{
     // Join the zyre group for this topic if node is running
     if (_node)
     {
+        std::lock_guard<std::mutex> lock(_sendMutex);
         zyre_join(_node, namespacedTopic.c_str());
     }
 }
 
-void ZyreSubscriber::receiveLoop() 
+void ZyreSubscriber::addHandler(const std::string &namespacedTopic, HandlerPtr entry)
+{
+    std::vector<std::string> peers;
+    {
+        std::lock_guard<std::mutex> lock(_handlersMutex);
+        _handlers[namespacedTopic] = std::move(entry);
+        peers.assign(_snapshotPeers.begin(), _snapshotPeers.end());
+    }
+
+    // Caches that are already known won't ENTER again, so ask them now
+    for (const auto &peer : peers)
+    {
+        requestSnapshots(peer, {namespacedTopic});
+    }
+}
+
+void ZyreSubscriber::requestSnapshots(const std::string &peer, const std::vector<std::string> &topics)
+{
+    if (!_node || topics.empty())
+    {
+        return;
+    }
+
+    zmsg_t *request = LastValueCache::buildRequest(topics);
+    std::lock_guard<std::mutex> lock(_sendMutex);
+    if (zyre_whisper(_node, peer.c_str(), &request) != 0 && request)
+    {
+        zmsg_destroy(&request);
+    }
+}
+
+void ZyreSubscriber::handleSnapshot(zmsg_t *zmsg)
 {
-    while (true) 
+    if (!LastValueCache::isCommand(zmsg, LastValueCache::kReplyCommand))
     {
-        zyre_event_t *event = zyre_event_new(_node);
-        std::cout << "Received Event" << std::endl;
-        const char *type = zyre_event_type(event);
+        return;
+    }
 
-        // Check for STOP event - indicates zyre_stop() was called
-        if (type && strcmp(type, "STOP") == 0)
+    // Remaining frames are [topic][payload] pairs
+    zframe_t *topicFrame = zmsg_next(zmsg);
+    while (topicFrame)
+    {
+        zframe_t *dataFrame = zmsg_next(zmsg);
+        if (!dataFrame)
         {
-            zyre_event_destroy(&event);
             break;
         }
 
-        if (type && strcmp(type, "SHOUT") == 0) 
+        dispatch(std::string_view(reinterpret_cast<const char*>(zframe_data(topicFrame)), zframe_size(topicFrame)),
+                 std::string_view(reinterpret_cast<const char*>(zframe_data(dataFrame)), zframe_size(dataFrame)));
+
+        topicFrame = zmsg_next(zmsg);
+    }
+}
+
+ZyreSubscriber::HandlerPtr ZyreSubscriber::findHandler(std::string_view topic)
+{
+    // Only a reference count is taken under the lock
+    std::lock_guard<std::mutex> lock(_handlersMutex);
+    auto it = _handlers.find(topic);
+    return it != _handlers.end() ? it->second : nullptr;
+}
+
+void ZyreSubscriber::invoke(const HandlerEntry &entry, std::string_view topic, std::string_view data)
+{
+    if (entry.viewHandler)
+    {
+        entry.viewHandler(topic, data);
+    }
+    else if (entry.handler)
+    {
+        // Legacy handlers get their own copies
+        entry.handler(std::string(topic), std::string(data));
+    }
+}
+
+void ZyreSubscriber::dispatch(std::string_view topic, std::string_view data)
+{
+    HandlerPtr entry = findHandler(topic);
+    if (entry)
+    {
+        invoke(*entry, topic, data);
+    }
+}
+
+void ZyreSubscriber::handleEvent(zyre_event_t *event)
+{
+    const char *type = zyre_event_type(event);
+
+    if (type && strcmp(type, "SHOUT") == 0) 
+    {
+        const char *group = zyre_event_group(event);
+        zmsg_t *zmsg = zyre_event_msg(event);
+        
+        HandlerPtr entry = (zmsg && group) ? findHandler(group) : nullptr;
+        if (entry)
+        {
+            // Batched shouts carry one message per frame. Frames are
+            // viewed in place; the event owns them until destroyed.
+            for (zframe_t *frame = zmsg_first(zmsg); frame; frame = zmsg_next(zmsg))
+            {
+                invoke(*entry, group, std::string_view(reinterpret_cast<const char*>(zframe_data(frame)),
+                                                       zframe_size(frame)));
+            }
+        }
+    }
+    else if (type && strcmp(type, "ENTER") == 0)
+    {
+        // A publisher in our namespace with a last-value cache: ask it
+        // for the current value of everything we subscribe to
+        const char *cacheNamespace = zyre_event_header(event, LastValueCache::kHeaderName);
+        if (cacheNamespace && _nodeName == cacheNamespace)
         {
-            const char *group = zyre_event_group(event);
-            zmsg_t *zmsg = zyre_event_get_msg(event);
-            
-            if (zmsg && group) 
+            std::string peer = zyre_event_peer_uuid(event);
+            std::vector<std::string> topics;
             {
-                std::string topic(group);
-                
-                // Get raw binary data from the message
-                zframe_t *frame = zmsg_first(zmsg);
-                if (frame)
+                std::lock_guard<std::mutex> lock(_handlersMutex);
+                _snapshotPeers.insert(peer);
+                for (const auto &entry : _handlers)
                 {
-                    std::string data(reinterpret_cast<const char*>(zframe_data(frame)), 
-                                     zframe_size(frame));
-                    
-                    // Find and invoke the handler
-                    MessageHandler handler;
-                    {
-                        std::lock_guard<std::mutex> lock(_handlersMutex);
-                        auto it = _handlers.find(topic);
-                        if (it != _handlers.end())
-                        {
-                            handler = it->second;
-                        }
-                    }
-                    
-                    if (handler)
-                    {
-                        handler(topic, data);
-                    }
+                    topics.push_back(entry.first);
                 }
-                zmsg_destroy(&zmsg);
             }
+            requestSnapshots(peer, topics);
         }
 
-        zyre_event_destroy(&event);
+        std::map<std::string, PeerHeaderHandler> watchers;
+        {
+            std::lock_guard<std::mutex> lock(_handlersMutex);
+            watchers = _peerHeaderHandlers;
+        }
+        for (const auto &watcher : watchers)
+        {
+            const char *value = zyre_event_header(event, watcher.first.c_str());
+            if (value)
+            {
+                watcher.second(zyre_event_peer_uuid(event), value);
+            }
+        }
+    }
+    else if (type && strcmp(type, "EXIT") == 0)
+    {
+        std::lock_guard<std::mutex> lock(_handlersMutex);
+        _snapshotPeers.erase(zyre_event_peer_uuid(event));
+    }
+    else if (type && strcmp(type, "WHISPER") == 0)
+    {
+        handleSnapshot(zyre_event_msg(event));
     }
 }
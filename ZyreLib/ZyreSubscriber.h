@@ -4,9 +4,12 @@
 #include "ZyreNode.h"
 
 #include <functional>
+#include <map>
+#include <memory>
 #include <string>
-#include <thread>
-#include <unordered_map>
+#include <string_view>
+#include <unordered_set>
+#include <vector>
 
 class ZyreSubscriber : public ZyreNode 
 {
@@ -14,19 +17,58 @@ public:
     // Callback type: receives the raw message data as a string
     using MessageHandler = std::function<void(const std::string &topic, const std::string &data)>;
 
-    explicit ZyreSubscriber(const std::string &name);
+    // Zero-copy callback type: views point straight into the received
+    // frame and are only valid for the duration of the call
+    using MessageViewHandler = std::function<void(std::string_view topic, std::string_view data)>;
+
+    // Callback for a header advertised by a peer that entered the network
+    using PeerHeaderHandler = std::function<void(const std::string &peer, const std::string &value)>;
+
+    explicit ZyreSubscriber(const std::string &name, ZyreReactor *reactor = nullptr,
+                    const ZyreNodeConfig &config = ZyreNodeConfig());
     ~ZyreSubscriber();
 
     // Subscribe to a topic with a handler callback
     // Can be called at any time while the subscriber is running
+    // Publishers with a last-value cache are asked for the topic's current
+    // value, which is delivered to the handler like a normal message
     void subscribe(const std::string &topic, MessageHandler handler);
 
+    // Subscribe with a zero-copy handler; otherwise identical to subscribe()
+    void subscribeView(const std::string &topic, MessageViewHandler handler);
+
+    // Only receive last-value snapshots for a topic, without joining its
+    // group. For transports whose live data arrives elsewhere.
+    void subscribeSnapshots(const std::string &topic, MessageHandler handler);
+
+    // Call handler for every peer advertising the given header, including
+    // peers already known when the handler is registered. A peer entering
+    // while the handler is being registered may be reported twice.
+    void watchPeerHeader(const std::string &header, PeerHeaderHandler handler);
+
 private:
-    void receiveLoop();
+    // Exactly one of the two callbacks is set
+    struct HandlerEntry
+    {
+        MessageHandler handler;
+        MessageViewHandler viewHandler;
+    };
+    using HandlerPtr = std::shared_ptr<const HandlerEntry>;
+
+    void handleEvent(zyre_event_t *event) override;
+    void join(const std::string &namespacedTopic);
+    void addHandler(const std::string &namespacedTopic, HandlerPtr entry);
+    void requestSnapshots(const std::string &peer, const std::vector<std::string> &topics);
+    void handleSnapshot(zmsg_t *zmsg);
+    HandlerPtr findHandler(std::string_view topic);
+    static void invoke(const HandlerEntry &entry, std::string_view topic, std::string_view data);
+    void dispatch(std::string_view topic, std::string_view data);
 
-    std::unordered_map<std::string, MessageHandler> _handlers;
+    // std::less<> allows lookup by string_view without building a string
+    std::map<std::string, HandlerPtr, std::less<>> _handlers;
     std::mutex _handlersMutex;
-    std::thread _receiveThread;
+    std::unordered_set<std::string> _snapshotPeers;  // Peers serving a last-value cache
+    std::map<std::string, PeerHeaderHandler> _peerHeaderHandlers;  // Header name -> handler
 };
 
-#endif // ZYRESUBSCRIBER_H
\ No newline at end of file
+#endif // ZYRESUBSCRIBER_H
@@ -14,6 +14,8 @@ int main()
     zsys_handler_set(NULL);
 
     ZyrePublisher pub("TestZyre");
+    // Late subscribers get the current value instead of waiting 2 seconds
+    pub.enableLastValueCache(64 * 1024);
     pub.start();
 
     while (true)
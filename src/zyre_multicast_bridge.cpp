@@ -0,0 +1,167 @@
+#include "HighBandwidthPublisher.h"
+#include "HighBandwidthSubscriber.h"
+#include "ZyrePublisher.h"
+#include "ZyreSubscriber.h"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdlib>
+#include <cstring>
+#include <iostream>
+#include <set>
+#include <string>
+#include <thread>
+
+#include <czmq.h>
+
+// Forwards selected topics between Zyre groups and UDP multicast within one
+// namespace. Payloads are relayed as received bytes, never parsed or
+// re-serialized, so the bridge does not need the message types.
+
+static volatile bool running = true;
+
+void signalHandler(int signum) {
+    std::cout << "\nReceived signal " << signum << ", shutting down..." << std::endl;
+    running = false;
+}
+
+static void usage(const char *program)
+{
+    std::cerr << "Usage: " << program << " <namespace> [options]\n"
+              << "  --to-multicast <topic>  Forward a Zyre topic to multicast (repeatable)\n"
+              << "  --to-zyre <topic>       Forward a multicast topic to Zyre (repeatable)\n"
+              << "  --group <address>       Multicast group (default: 239.192.1.1)\n"
+              << "  --port <port>           Multicast port (default: 5670)\n";
+}
+
+int main(int argc, char *argv[])
+{
+    if (argc < 2)
+    {
+        usage(argv[0]);
+        return 1;
+    }
+
+    std::string name = argv[1];
+    std::string group = "239.192.1.1";
+    uint16_t port = 5670;
+    std::set<std::string> toMulticast;
+    std::set<std::string> toZyre;
+
+    for (int i = 2; i < argc; ++i)
+    {
+        if (i + 1 >= argc)
+        {
+            usage(argv[0]);
+            return 1;
+        }
+
+        if (strcmp(argv[i], "--to-multicast") == 0)
+        {
+            toMulticast.insert(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--to-zyre") == 0)
+        {
+            toZyre.insert(argv[++i]);
+        }
+        else if (strcmp(argv[i], "--group") == 0)
+        {
+            group = argv[++i];
+        }
+        else if (strcmp(argv[i], "--port") == 0)
+        {
+            port = static_cast<uint16_t>(std::atoi(argv[++i]));
+        }
+        else
+        {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    // A topic bridged both ways would be echoed back forever
+    for (const auto &topic : toMulticast)
+    {
+        if (toZyre.count(topic))
+        {
+            std::cerr << "Topic " << topic << " cannot be bridged in both directions" << std::endl;
+            return 1;
+        }
+    }
+
+    if (toMulticast.empty() && toZyre.empty())
+    {
+        std::cerr << "No topics to bridge" << std::endl;
+        usage(argv[0]);
+        return 1;
+    }
+
+    // Disable CZMQ's signal handling so we can use our own
+    zsys_handler_set(NULL);
+    signal(SIGINT, signalHandler);
+    signal(SIGTERM, signalHandler);
+
+    std::atomic<uint64_t> forwardedToMulticast{0};
+    std::atomic<uint64_t> forwardedToZyre{0};
+
+    // Zyre -> multicast
+    HighBandwidthPublisher multicastPub(name, group, port);
+    ZyreSubscriber zyreSub(name);
+    for (const auto &topic : toMulticast)
+    {
+        zyreSub.subscribeView(topic, [&multicastPub, &forwardedToMulticast, topic](std::string_view, std::string_view data)
+        {
+            if (multicastPub.publishRaw(topic, data.data(), data.size()))
+            {
+                forwardedToMulticast.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    // Multicast -> Zyre
+    ZyrePublisher zyrePub(name);
+    HighBandwidthSubscriber multicastSub(name, group, port);
+    for (const auto &topic : toZyre)
+    {
+        multicastSub.subscribe(topic, [&zyrePub, &forwardedToZyre, topic](const std::string &, const std::string &data)
+        {
+            if (zyrePub.publishRaw(topic, data.data(), data.size()))
+            {
+                forwardedToZyre.fetch_add(1, std::memory_order_relaxed);
+            }
+        });
+    }
+
+    if (!zyrePub.start())
+    {
+        std::cerr << "Failed to start Zyre publisher" << std::endl;
+        return 1;
+    }
+    if (!toZyre.empty() && !multicastSub.start())
+    {
+        std::cerr << "Failed to start multicast subscriber" << std::endl;
+        return 1;
+    }
+
+    std::cout << "Bridging namespace " << name << " (" << toMulticast.size() << " topics to multicast, "
+              << toZyre.size() << " to Zyre). Press Ctrl+C to exit." << std::endl;
+
+    auto lastReport = std::chrono::steady_clock::now();
+    while (running)
+    {
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+        auto now = std::chrono::steady_clock::now();
+        if (now - lastReport >= std::chrono::seconds(10))
+        {
+            std::cout << "Forwarded " << forwardedToMulticast.load() << " to multicast, "
+                      << forwardedToZyre.load() << " to Zyre" << std::endl;
+            lastReport = now;
+        }
+    }
+
+    multicastSub.stop();
+    std::cout << "Bridge stopped." << std::endl;
+
+    return 0;
+}